@@ -0,0 +1,135 @@
+/*****************************************************************//**
+ * \file	MappingBenchmark.cpp
+ * \brief	Compile, reload and lookup cost of large mapping files.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MappingTable.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace mackieControl;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Mapping of note, controller and fader rules on all channels with mixed modifiers.
+ */
+static std::string createMapping(int ruleNum, int actionNum, int seed) {
+	static const char* modifiers[] = { "", " shift", " option", " control+shift", " cmdalt", " *" };
+
+	std::string text;
+	text.reserve(ruleNum * 40);
+	for (int i = 0; i < ruleNum; i++) {
+		int value = i * 7 + seed;
+		switch (i % 8) {
+		case 0:
+			text += "fader " + std::to_string(1 + value % 9);
+			break;
+		case 1:
+			text += "cc " + std::to_string(16 + value % 16) + "/" + std::to_string(1 + value % 16);
+			break;
+		default:
+			text += "note ";
+			text += MappingTable::getName(validNoteMessage[value % validNoteMessage.size()]);
+			text += "/" + std::to_string(1 + value % 16);
+			break;
+		}
+		text += modifiers[value % 6];
+		text += " = action" + std::to_string(value % actionNum) + " # generated\n";
+	}
+	return text;
+}
+
+static double getMilliseconds(Clock::time_point start) {
+	std::chrono::duration<double, std::milli> time = Clock::now() - start;
+	return time.count();
+}
+
+/**
+ * Usage: MappingBenchmark [ruleNum] [readerThreads] [reloads]
+ */
+int main(int argc, char* argv[]) {
+	int ruleNum = (argc > 1) ? std::atoi(argv[1]) : 5000;
+	int threadNum = (argc > 2) ? std::atoi(argv[2]) : 4;
+	int reloadNum = (argc > 3) ? std::atoi(argv[3]) : 50;
+	if (ruleNum <= 0 || threadNum < 0 || reloadNum <= 0) { return 1; }
+
+	std::vector<std::string> actions;
+	for (int i = 0; i < 500; i++) {
+		actions.push_back("action" + std::to_string(i));
+	}
+	std::vector<std::string> mappings = { createMapping(ruleNum, 500, 0), createMapping(ruleNum, 500, 1) };
+
+	//Compile
+	double compileMs = 0;
+	std::size_t byteSize = 0;
+	int compiledRules = 0;
+	for (int i = 0; i < reloadNum; i++) {
+		auto start = Clock::now();
+		auto table = MappingTable::compile(mappings[i & 1], actions);
+		compileMs += getMilliseconds(start);
+		if (!table) {
+			std::printf("Mapping failed to compile\n");
+			return 1;
+		}
+		byteSize = table->getByteSize();
+		compiledRules = table->getRuleNum();
+	}
+
+	//Reload while other threads look up inputs
+	MappingDispatcher dispatcher;
+	dispatcher.load(mappings[0], actions);
+	std::atomic<bool> running = true;
+	std::vector<uint64_t> lookups(threadNum);
+	std::atomic<uint64_t> hits = 0;
+	std::vector<std::thread> readers;
+	for (int i = 0; i < threadNum; i++) {
+		readers.emplace_back([&, i] {
+			uint64_t count = 0, found = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				auto type = validNoteMessage[count % validNoteMessage.size()];
+				found += dispatcher.lookup(MappingKind::Note, static_cast<int>(type), 1 + count % 16,
+					static_cast<ModifierFlags>(count & 15)) != MappingTable::NoAction;
+				count++;
+			}
+			lookups[i] = count;
+			hits += found;
+		});
+	}
+
+	std::vector<double> reloadMs;
+	auto lookupStart = Clock::now();
+	for (int i = 0; i < reloadNum; i++) {
+		auto start = Clock::now();
+		dispatcher.load(mappings[(i + 1) & 1], actions);
+		reloadMs.push_back(getMilliseconds(start));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds{ 200 });
+	running = false;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+	double lookupSeconds = getMilliseconds(lookupStart) / 1000;
+
+	uint64_t totalLookups = 0;
+	for (auto count : lookups) {
+		totalLookups += count;
+	}
+	std::sort(reloadMs.begin(), reloadMs.end());
+
+	std::printf("mapping:     %d rules, %zu bytes of text, %zu bytes of table\n",
+		compiledRules, mappings[0].size(), byteSize);
+	std::printf("compile:     %.2f ms\n", compileMs / reloadNum);
+	std::printf("reload:      p50 %.2f ms, max %.2f ms with %d reader threads (compile and grace period)\n",
+		reloadMs[reloadMs.size() / 2], reloadMs.back(), threadNum);
+	std::printf("lookup:      %.0f lookups/s per thread during reloads, %llu mapped\n",
+		threadNum ? totalLookups / lookupSeconds / threadNum : 0.0, static_cast<unsigned long long>(hits.load()));
+	return 0;
+}
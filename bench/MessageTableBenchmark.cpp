@@ -0,0 +1,94 @@
+/*****************************************************************//**
+ * \file	MessageTableBenchmark.cpp
+ * \brief	Prebuilt table messages against creating each message.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageTable.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace mackieControl;
+
+/**
+ * Time one way of producing count messages into a reused vector, in nanoseconds per message.
+ */
+template <typename Producer>
+static double measure(int count, std::vector<Message>& output, uint64_t& sink, Producer&& produce) {
+	output.clear();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; i++) {
+		produce(i, output);
+	}
+	std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+
+	for (auto& message : output) {
+		sink += message.getRawData()[message.getRawDataSize() - 1];
+	}
+	return time.count() / count;
+}
+
+template <typename Producer>
+static double measureBytes(int count, uint64_t& sink, Producer&& produce) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; i++) {
+		sink += produce(i)[1];
+	}
+	std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+	return time.count() / count;
+}
+
+static void print(const char* name, double create, double table, double bytes) {
+	std::printf("%-16s create %6.1f ns, table %6.1f ns (%.1fx), bytes %5.1f ns\n",
+		name, create, table, create / table, bytes);
+}
+
+/**
+ * Usage: MessageTableBenchmark [messageNum]
+ */
+int main(int argc, char* argv[]) {
+	int count = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+	if (count <= 0) { return 1; }
+
+	auto& table = MessageTable::getInstance();
+	std::vector<Message> output;
+	output.reserve(count);
+	uint64_t sink = 0;
+
+	auto noteType = [](int i) { return validNoteMessage[i % validNoteMessage.size()]; };
+	auto noteVel = [](int i) { return (i & 1) ? VelocityMessage::On : VelocityMessage::Off; };
+	double createNote = measure(count, output, sink, [&](int i, std::vector<Message>& out) {
+		out.emplace_back(Message::createNote(noteType(i), noteVel(i))); });
+	double tableNote = measure(count, output, sink, [&](int i, std::vector<Message>& out) {
+		out.emplace_back(table.getNote(noteType(i), noteVel(i))); });
+	double bytesNote = measureBytes(count, sink, [&](int i) {
+		return MessageTable::getNoteBytes(noteType(i), noteVel(i)); });
+	print("LED", createNote, tableNote, bytesNote);
+
+	auto ringValue = [](int i) { return Message::toVPotLEDRingValue(false, VPotLEDRingMode::WrapMode, i % 12); };
+	double createRing = measure(count, output, sink, [&](int i, std::vector<Message>& out) {
+		out.emplace_back(Message::createCC(static_cast<CCMessage>(static_cast<int>(CCMessage::VPotLEDRing1) + i % 8),
+			ringValue(i))); });
+	double tableRing = measure(count, output, sink, [&](int i, std::vector<Message>& out) {
+		out.emplace_back(table.getVPotLEDRing(1 + i % 8, ringValue(i))); });
+	double bytesRing = measureBytes(count, sink, [&](int i) {
+		return MessageTable::getVPotLEDRingBytes(1 + i % 8, ringValue(i)); });
+	print("V-Pot LED ring", createRing, tableRing, bytesRing);
+
+	double createMeter = measure(count, output, sink, [&](int i, std::vector<Message>& out) {
+		out.emplace_back(Message::createChannelPressure(1 + i % 8, i % 13)); });
+	double tableMeter = measure(count, output, sink, [&](int i, std::vector<Message>& out) {
+		out.emplace_back(table.getChannelPressure(1 + i % 8, i % 13)); });
+	double bytesMeter = measureBytes(count, sink, [&](int i) {
+		return MessageTable::getChannelPressureBytes(1 + i % 8, i % 13); });
+	print("meter", createMeter, tableMeter, bytesMeter);
+
+	std::printf("(checksum %llu)\n", static_cast<unsigned long long>(sink));
+	return 0;
+}
@@ -0,0 +1,46 @@
+/*****************************************************************//**
+ * \file	RTPMIDIBenchmark.cpp
+ * \brief	Packet rate and latency of the RTP-MIDI transport on loopback.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "RTPMIDILoopback.h"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace mackieControl;
+
+/**
+ * Usage: RTPMIDIBenchmark [messageNum] [messagesPerPacket] [latencyNum]
+ */
+int main(int argc, char* argv[]) {
+	RTPMIDILoopback::Config config;
+	if (argc > 1) { config.messageNum = std::atoi(argv[1]); }
+	if (argc > 2) { config.messagesPerPacket = std::atoi(argv[2]); }
+	if (argc > 3) { config.latencyNum = std::atoi(argv[3]); }
+
+	auto report = RTPMIDILoopback::run(config);
+	if (!report.connected) {
+		std::printf("Can't bind to %s\n", config.address.toRawUTF8());
+		return 1;
+	}
+
+	std::printf("messages:    %llu sent, %llu received, %llu mismatched\n",
+		static_cast<unsigned long long>(report.messagesSent),
+		static_cast<unsigned long long>(report.messagesReceived),
+		static_cast<unsigned long long>(report.mismatches));
+	std::printf("packets:     %llu sent, %llu received, %llu lost\n",
+		static_cast<unsigned long long>(report.packetsSent),
+		static_cast<unsigned long long>(report.packetsReceived),
+		static_cast<unsigned long long>(report.packetsLost));
+	std::printf("throughput:  %.0f packets/s, %.0f messages/s (%d messages per packet)\n",
+		report.packetsPerSecond, report.messagesPerSecond, config.messagesPerPacket);
+	std::printf("latency us:  p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+		report.p50, report.p90, report.p99, report.max);
+	return report.mismatches ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+/*****************************************************************//**
+ * \file	RTPMIDILoopback.cpp
+ * \brief	Loopback benchmark of the RTP-MIDI transport.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "RTPMIDILoopback.h"
+#include <chrono>
+
+namespace mackieControl {
+	static Message createMessage(int index) {
+		//The index is carried in the pitch wheel value, so every message can be checked
+		return Message::createPitchWheel(1 + index % 9, index & 0x3FFF);
+	}
+
+	static Message createSysEx(int index, int size) {
+		std::vector<uint8_t> data(size);
+		data.front() = 0xF0;
+		for (int i = 1; i < size - 1; i++) {
+			data[i] = static_cast<uint8_t>((index + i) & 0x7F);
+		}
+		data.back() = 0xF7;
+		return Message{ MidiMessage{ data.data(), size } };
+	}
+
+	static bool isSame(const Message& a, const Message& b) {
+		return a.getRawDataSize() == b.getRawDataSize()
+			&& std::equal(a.getRawData(), a.getRawData() + a.getRawDataSize(), b.getRawData());
+	}
+
+	static double getPercentile(const std::vector<float>& sorted, double percentile) {
+		if (sorted.empty()) { return 0; }
+		auto index = static_cast<std::size_t>(percentile * (sorted.size() - 1));
+		return sorted[index];
+	}
+
+	RTPMIDILoopback::Report RTPMIDILoopback::run(const Config& config) {
+		using Clock = std::chrono::steady_clock;
+
+		Report report;
+
+		//Packets are only sent by flush(), or when they are full
+		RTPMIDITransport::Config transportConfig;
+		transportConfig.batchWindowMs = 1e9;
+		transportConfig.maxPayloadSize = config.maxPayloadSize;
+		RTPMIDITransport sender{ transportConfig }, receiver{ transportConfig };
+		if (!sender.bind(0, config.address) || !receiver.bind(0, config.address)) { return report; }
+		sender.setPeer(config.address, receiver.getBoundPort());
+		report.connected = true;
+
+		std::vector<Message> expected, received;
+		std::size_t checked = 0;
+		auto check = [&] {
+			for (; checked < received.size(); checked++) {
+				if (checked >= expected.size() || !isSame(received[checked], expected[checked])) {
+					report.mismatches++;
+				}
+			}
+		};
+
+		auto wallStart = Clock::now();
+		auto getTime = [&] {
+			std::chrono::duration<double, std::milli> time = Clock::now() - wallStart;
+			return time.count();
+		};
+
+		//Throughput: the receiver drains its socket after each packet, so the socket buffer never overflows
+		int perPacket = std::max(config.messagesPerPacket, 1);
+		int sysExSize = config.maxPayloadSize * 2 + 3;
+		expected.reserve(config.messageNum + config.messageNum / perPacket + 1);
+		received.reserve(expected.capacity());
+		for (int i = 0, packet = 0; i < config.messageNum; packet++) {
+			double time = getTime();
+			if (config.sysExInterval > 0 && packet % config.sysExInterval == config.sysExInterval - 1) {
+				expected.emplace_back(createSysEx(packet, sysExSize));
+				sender.send(expected.back(), time);
+			}
+			for (int j = 0; j < perPacket && i < config.messageNum; j++, i++) {
+				expected.emplace_back(createMessage(i));
+				sender.send(expected.back(), time);
+			}
+			sender.flush();
+			receiver.receive(received, 0);
+			check();
+		}
+		while (received.size() < expected.size() && receiver.receive(received, 100) > 0) {}
+		check();
+
+		std::chrono::duration<double> wallTime = Clock::now() - wallStart;
+		report.wallSeconds = wallTime.count();
+
+		//Rates only cover the throughput run, counted before the latency run adds to the counters
+		uint64_t throughputPackets = sender.getCounters().packetsSent;
+		uint64_t throughputMessages = expected.size();
+
+		//Latency: one message per packet, from send() to the return of receive()
+		std::vector<float> latencies;
+		latencies.reserve(config.latencyNum);
+		for (int i = 0; i < config.latencyNum; i++) {
+			expected.emplace_back(createMessage(i));
+			std::size_t before = received.size();
+
+			auto start = Clock::now();
+			sender.send(expected.back(), getTime());
+			sender.flush();
+			receiver.receive(received, 100);
+			std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+
+			if (received.size() > before) {
+				latencies.push_back(static_cast<float>(elapsed.count()));
+			}
+			check();
+		}
+
+		auto& sent = sender.getCounters();
+		auto& counters = receiver.getCounters();
+		report.packetsSent = sent.packetsSent;
+		report.packetsReceived = counters.packetsReceived;
+		report.packetsLost = counters.packetsLost;
+		report.messagesSent = expected.size();
+		report.messagesReceived = received.size();
+		report.mismatches += expected.size() - std::min(expected.size(), received.size());
+
+		report.packetsPerSecond = (report.wallSeconds > 0) ? throughputPackets / report.wallSeconds : 0;
+		report.messagesPerSecond = (report.wallSeconds > 0) ? throughputMessages / report.wallSeconds : 0;
+
+		std::sort(latencies.begin(), latencies.end());
+		report.p50 = getPercentile(latencies, 0.5);
+		report.p90 = getPercentile(latencies, 0.9);
+		report.p99 = getPercentile(latencies, 0.99);
+		report.max = latencies.empty() ? 0 : latencies.back();
+
+		return report;
+	}
+}
@@ -0,0 +1,78 @@
+/*****************************************************************//**
+ * \file	RTPMIDILoopback.h
+ * \brief	Loopback benchmark of the RTP-MIDI transport.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "RTPMIDITransport.h"
+
+namespace mackieControl {
+	/**
+	 * Send a stream of messages between two RTPMIDITransports bound to the loopback interface, check that every message
+	 * arrives unchanged and in order, and measure packet rate and send to receive latency.
+	 * Both transports run on the calling thread, so the latency covers encoding, the loopback socket and decoding.
+	 */
+	class RTPMIDILoopback final {
+	public:
+		/**
+		 * Benchmark settings.
+		 */
+		struct Config final {
+			/**
+			 * Number of messages of the throughput run.
+			 */
+			int messageNum = 200000;
+			/**
+			 * Number of messages packed into each packet of the throughput run.
+			 */
+			int messagesPerPacket = 8;
+			/**
+			 * Number of single message packets of the latency run.
+			 */
+			int latencyNum = 10000;
+			/**
+			 * Send a system exclusive message longer than one packet every this many packets. 0 for none.
+			 */
+			int sysExInterval = 64;
+			/**
+			 * Maximum size of the MIDI command list of a packet (bytes).
+			 */
+			int maxPayloadSize = 256;
+			/**
+			 * Loopback address to bind both transports to.
+			 */
+			String address = "127.0.0.1";
+		};
+
+		/**
+		 * Benchmark results. Latencies are in microseconds.
+		 */
+		struct Report final {
+			bool connected = false;
+			uint64_t packetsSent = 0;
+			uint64_t packetsReceived = 0;
+			uint64_t packetsLost = 0;
+			uint64_t messagesSent = 0;
+			uint64_t messagesReceived = 0;
+			uint64_t mismatches = 0;
+			double wallSeconds = 0;
+			double packetsPerSecond = 0;
+			double messagesPerSecond = 0;
+			double p50 = 0, p90 = 0, p99 = 0, max = 0;
+		};
+
+		RTPMIDILoopback() = delete;
+
+		/**
+		 * Run the benchmark.
+		 */
+		static Report run(const Config& config);
+	};
+}
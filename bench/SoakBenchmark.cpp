@@ -0,0 +1,40 @@
+/*****************************************************************//**
+ * \file	SoakBenchmark.cpp
+ * \brief	Soak run of an emulated Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SoakTest.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace mackieControl;
+
+/**
+ * Usage: SoakBenchmark [messageNum] [messagesPerSecond] [xt]
+ */
+int main(int argc, char* argv[]) {
+	SoakTest::Config config;
+	if (argc > 1) { config.messageNum = std::strtoull(argv[1], nullptr, 10); }
+	if (argc > 2) { config.messagesPerSecond = std::atof(argv[2]); }
+	if (argc > 3) { config.extender = std::strcmp(argv[3], "xt") == 0; }
+
+	auto report = SoakTest::run(config);
+
+	std::printf("messages:    %llu host, %llu surface, %llu invalid, %llu bytes\n",
+		static_cast<unsigned long long>(report.hostMessages),
+		static_cast<unsigned long long>(report.surfaceMessages),
+		static_cast<unsigned long long>(report.invalidMessages),
+		static_cast<unsigned long long>(report.bytes));
+	std::printf("time:        %.2f s simulated in %.2f s, %.0f messages/s\n",
+		report.simulatedSeconds, report.wallSeconds, report.messagesPerWallSecond);
+	std::printf("latency us:  p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+		report.p50, report.p90, report.p99, report.p999, report.max);
+	return report.invalidMessages ? 1 : 0;
+}
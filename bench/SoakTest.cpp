@@ -0,0 +1,112 @@
+/*****************************************************************//**
+ * \file	SoakTest.cpp
+ * \brief	Soak test harness on an emulated Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SoakTest.h"
+#include <chrono>
+
+namespace mackieControl {
+	static Message createHostMessage(uint64_t index) {
+		int value = static_cast<int>(index / 6);
+		switch (index % 6) {
+		case 0:
+			return Message::createPitchWheel(1 + value % SurfaceState::FaderNum, (value * 37) % (1 << 14));
+		case 1:
+			return Message::createNote(static_cast<NoteMessage>(value % (static_cast<int>(NoteMessage::Relayclick) + 1)),
+				(value & 1) ? VelocityMessage::On : VelocityMessage::Off);
+		case 2:
+			return Message::createCC(static_cast<CCMessage>(static_cast<int>(CCMessage::VPotLEDRing1) + value % 8),
+				Message::toVPotLEDRingValue(value & 1, static_cast<VPotLEDRingMode>(value % 4), value % 12));
+		case 3:
+			return Message::createChannelPressure(1 + value % 8, value % 13);
+		case 4: {
+			char text[7];
+			for (int i = 0; i < 7; i++) {
+				text[i] = static_cast<char>('A' + (value + i) % 26);
+			}
+			return Message::createLCD(Message::toLCDPlace(value & 1, static_cast<uint8_t>((value % 8) * 7)), text, 7);
+		}
+		default:
+			return Message::createCC(static_cast<CCMessage>(static_cast<int>(CCMessage::TimeCodeBBTDisplay1) + value % 10),
+				Message::charToMackie(static_cast<char>('0' + value % 10)));
+		}
+	}
+
+	static double getPercentile(const std::vector<float>& sorted, double percentile) {
+		if (sorted.empty()) { return 0; }
+		auto index = static_cast<std::size_t>(percentile * (sorted.size() - 1));
+		return sorted[index];
+	}
+
+	SoakTest::Report SoakTest::run(const Config& config) {
+		using Clock = std::chrono::steady_clock;
+
+		Report report;
+		VirtualSurface surface{ config.extender };
+		surface.setInputConfig(config.input);
+		VirtualLink hostToSurface{ config.linkBytesPerSecond }, surfaceToHost{ config.linkBytesPerSecond };
+
+		std::vector<float> latencies;
+		latencies.reserve(config.messageNum * 2);
+		std::vector<uint8_t> wire;
+		std::vector<Message> input;
+
+		double interval = 1.0 / config.messagesPerSecond;
+		auto wallStart = Clock::now();
+
+		for (uint64_t i = 0; i < config.messageNum; i++) {
+			double time = i * interval;
+
+			//Host to surface: encode, link, decode
+			auto start = Clock::now();
+			auto message = createHostMessage(i);
+			wire.assign(message.getRawData(), message.getRawData() + message.getRawDataSize());
+			double arrival = hostToSurface.send(static_cast<int>(wire.size()), time);
+			if (!surface.receive(wire.data(), static_cast<int>(wire.size()))) {
+				report.invalidMessages++;
+			}
+			std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+			latencies.push_back(static_cast<float>((arrival - time) * 1e6 + elapsed.count()));
+			report.hostMessages++;
+
+			//Surface to host: user input over the return link
+			input.clear();
+			surface.generateInput(interval, input);
+			for (auto& event : input) {
+				start = Clock::now();
+				wire.assign(event.getRawData(), event.getRawData() + event.getRawDataSize());
+				arrival = surfaceToHost.send(static_cast<int>(wire.size()), time);
+				Message decoded{ MidiMessage{ wire.data(), static_cast<int>(wire.size()) } };
+				if (!decoded.isMackieControl()) {
+					report.invalidMessages++;
+				}
+				elapsed = Clock::now() - start;
+				latencies.push_back(static_cast<float>((arrival - time) * 1e6 + elapsed.count()));
+				report.surfaceMessages++;
+			}
+		}
+
+		std::chrono::duration<double> wallTime = Clock::now() - wallStart;
+		report.wallSeconds = wallTime.count();
+		report.simulatedSeconds = config.messageNum * interval;
+		report.bytes = hostToSurface.getBytesSent() + surfaceToHost.getBytesSent();
+		report.messagesPerWallSecond = (report.wallSeconds > 0)
+			? (report.hostMessages + report.surfaceMessages) / report.wallSeconds : 0;
+
+		std::sort(latencies.begin(), latencies.end());
+		report.p50 = getPercentile(latencies, 0.5);
+		report.p90 = getPercentile(latencies, 0.9);
+		report.p99 = getPercentile(latencies, 0.99);
+		report.p999 = getPercentile(latencies, 0.999);
+		report.max = latencies.empty() ? 0 : latencies.back();
+
+		return report;
+	}
+}
@@ -0,0 +1,56 @@
+/*****************************************************************//**
+ * \file	SoakTest.h
+ * \brief	Soak test harness on an emulated Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "VirtualSurface.h"
+
+namespace mackieControl {
+	/**
+	 * Drive a virtual surface with a long stream of host messages, and measure encode, link and decode latency.
+	 * The link time is simulated; the encode and decode time is measured on this machine. Synthetic user input is
+	 * sent back from the surface over a second link in the same run.
+	 */
+	class SoakTest final {
+	public:
+		/**
+		 * Soak test settings.
+		 */
+		struct Config final {
+			uint64_t messageNum = 1000000;
+			double messagesPerSecond = 500;
+			double linkBytesPerSecond = VirtualLink::DINBytesPerSecond;
+			VirtualSurface::InputConfig input;
+			bool extender = false;
+		};
+
+		/**
+		 * Soak test results. Latencies are in microseconds.
+		 */
+		struct Report final {
+			uint64_t hostMessages = 0;
+			uint64_t surfaceMessages = 0;
+			uint64_t bytes = 0;
+			uint64_t invalidMessages = 0;
+			double wallSeconds = 0;
+			double simulatedSeconds = 0;
+			double messagesPerWallSecond = 0;
+			double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+		};
+
+		SoakTest() = delete;
+
+		/**
+		 * Run the soak test.
+		 */
+		static Report run(const Config& config);
+	};
+}
@@ -0,0 +1,134 @@
+/*****************************************************************//**
+ * \file	SurfaceHubBenchmark.cpp
+ * \brief	Throughput and latency of the surface hub against the number of surfaces.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceHub.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace mackieControl;
+
+static int64_t now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Move every fader and meter of the surface by one frame.
+ */
+static void change(SurfaceState& state, int frame) {
+	for (int i = 0; i < SurfaceState::FaderNum; i++) {
+		state.faders[i] = static_cast<uint16_t>((frame * 37 + i * 1000) % 16384);
+	}
+	for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+		state.meters[i] = static_cast<uint8_t>((frame + i) % 13);
+	}
+}
+
+struct Result final {
+	double statesPerSecond = 0;
+	double messagesPerSecond = 0;
+	double averageLatency = 0;
+	double maxLatency = 0;
+};
+
+/**
+ * Drive the hub with one state and one input message per surface and frame.
+ * Throughput is measured unpaced, latency (from posting a state to its first output message) at the frame rate.
+ */
+static Result run(int surfaceNum, int frameNum, double frameRate, int threadNum) {
+	std::vector<std::atomic<int64_t>> postedAt(surfaceNum);
+	std::vector<std::vector<int64_t>> latencies(surfaceNum);
+	std::atomic<uint64_t> outputNum = 0, inputNum = 0;
+
+	SurfaceHub hub{
+		[&inputNum](int, const Message&) { inputNum++; },
+		[&](int device, const Message&) {
+			outputNum++;
+			int64_t posted = postedAt[device].exchange(0);
+			if (posted != 0) {
+				//The callbacks of one device never run at the same time
+				latencies[device].push_back(now() - posted);
+			}
+		},
+		threadNum };
+	for (int i = 0; i < surfaceNum; i++) {
+		hub.addDevice();
+	}
+
+	std::vector<SurfaceState> states(surfaceNum);
+	const uint8_t touch[] = { 0x90, 0x68, 0x7F };
+
+	//Throughput
+	int64_t start = now();
+	for (int frame = 0; frame < frameNum; frame++) {
+		for (int i = 0; i < surfaceNum; i++) {
+			change(states[i], frame + i);
+			hub.postInput(i, touch, sizeof(touch));
+			hub.postState(i, states[i]);
+		}
+	}
+	hub.flush();
+	double elapsed = (now() - start) / 1e9;
+
+	Result result;
+	result.statesPerSecond = static_cast<double>(frameNum) * surfaceNum / elapsed;
+	result.messagesPerSecond = outputNum / elapsed;
+
+	//Latency
+	for (auto& list : latencies) {
+		list.clear();
+	}
+	int latencyFrameNum = std::max(static_cast<int>(frameRate / 4), 1);
+	auto period = std::chrono::nanoseconds{ static_cast<int64_t>(1e9 / frameRate) };
+	auto next = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < latencyFrameNum; frame++) {
+		for (int i = 0; i < surfaceNum; i++) {
+			change(states[i], frameNum + frame + i);
+			postedAt[i].store(now());
+			hub.postState(i, states[i]);
+		}
+		next += period;
+		std::this_thread::sleep_until(next);
+	}
+	hub.flush();
+
+	uint64_t latencyNum = 0;
+	double latencySum = 0;
+	for (auto& list : latencies) {
+		for (auto latency : list) {
+			latencySum += latency;
+			result.maxLatency = std::max(result.maxLatency, latency / 1e3);
+		}
+		latencyNum += list.size();
+	}
+	result.averageLatency = (latencyNum > 0) ? latencySum / latencyNum / 1e3 : 0;
+	return result;
+}
+
+/**
+ * Usage: SurfaceHubBenchmark [frameNum] [frameRate] [threadNum]
+ */
+int main(int argc, char* argv[]) {
+	int frameNum = (argc > 1) ? std::atoi(argv[1]) : 2000;
+	double frameRate = (argc > 2) ? std::atof(argv[2]) : 200;
+	int threadNum = (argc > 3) ? std::atoi(argv[3]) : 0;
+	if (frameNum <= 0 || frameRate <= 0 || threadNum < 0) { return 1; }
+
+	std::printf("surfaces  posted/s     messages/s   latency avg   latency max\n");
+	for (int surfaceNum : { 1, 2, 4, 8, 16, 32, 64 }) {
+		auto result = run(surfaceNum, frameNum, frameRate, threadNum);
+		std::printf("%8d  %-11.0f  %-11.0f  %8.1f us   %8.1f us\n", surfaceNum,
+			result.statesPerSecond, result.messagesPerSecond, result.averageLatency, result.maxLatency);
+	}
+	return 0;
+}
@@ -0,0 +1,103 @@
+/*****************************************************************//**
+ * \file	SurfaceMirrorBenchmark.cpp
+ * \brief	Bandwidth of surface mirroring under heavy automation.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceMirror.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace mackieControl;
+
+/**
+ * Advance the surface by one frame of a mix with automation on every fader: faders and meters move every frame, the
+ * LCD shows the changing values, and a few LEDs change.
+ */
+static void change(SurfaceState& state, int frame, double frameRate) {
+	double time = frame / frameRate;
+	for (int i = 0; i < SurfaceState::FaderNum; i++) {
+		double value = 0.5 + 0.4 * std::sin(time * (0.5 + i * 0.13));
+		state.faders[i] = static_cast<uint16_t>(value * 16383);
+	}
+	for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+		state.meters[i] = static_cast<uint8_t>(std::abs(std::sin(time * (3 + i))) * 12);
+		state.vPotLEDRings[i] = static_cast<uint8_t>(1 + static_cast<int>(5.5 + 5 * std::sin(time * (0.2 + i * 0.05))));
+	}
+	state.meterOverload = static_cast<uint8_t>((frame / 30) & 0x81);
+
+	//Lower line values change every 4 frames, the time code every frame
+	if (frame % 4 == 0) {
+		for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+			char text[8];
+			std::snprintf(text, sizeof(text), "%6.1f ", -60 + state.faders[i] / 16383.0 * 66);
+			std::copy(text, text + 7, state.LCD.begin() + SurfaceState::LCDLineSize + i * 7);
+		}
+	}
+	int ticks = static_cast<int>(time * 960);
+	for (int i = 0; i < 10; i++, ticks /= 10) {
+		state.timeCodeBBTDisplay[i] = static_cast<uint8_t>(0x30 + ticks % 10);
+	}
+	if (frame % 50 == 0) {
+		int note = (frame / 50) % 128;
+		state.LEDs[note] = (state.LEDs[note] == VelocityMessage::Off) ? VelocityMessage::On : VelocityMessage::Off;
+	}
+}
+
+/**
+ * Usage: SurfaceMirrorBenchmark [seconds] [frameRate] [keyframeInterval]
+ */
+int main(int argc, char* argv[]) {
+	double seconds = (argc > 1) ? std::atof(argv[1]) : 600;
+	double frameRate = (argc > 2) ? std::atof(argv[2]) : 60;
+	int keyframeInterval = (argc > 3) ? std::atoi(argv[3]) : 120;
+	if (seconds <= 0 || frameRate <= 0) { return 1; }
+
+	SurfaceState state;
+	SurfaceMirrorEncoder encoder{ keyframeInterval };
+	SurfaceMirrorDecoder decoder;
+	std::vector<uint8_t> frame;
+
+	int frameNum = static_cast<int>(seconds * frameRate);
+	uint64_t keyframeBytes = 0, deltaBytes = 0, emptyFrames = 0, mismatches = 0;
+	double encodeSeconds = 0;
+	for (int i = 0; i < frameNum; i++) {
+		change(state, i, frameRate);
+
+		frame.clear();
+		auto start = std::chrono::steady_clock::now();
+		int size = encoder.encode(state, frame);
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		encodeSeconds += elapsed.count();
+
+		if (size == 0) {
+			emptyFrames++;
+			continue;
+		}
+		(frame[0] == 0 ? keyframeBytes : deltaBytes) += size;
+		if (!decoder.decode(frame.data(), frame.size()) || !(decoder.getState() == state)) {
+			mismatches++;
+		}
+	}
+
+	auto counters = encoder.getCounters();
+	double rawBytesPerSecond = sizeof(SurfaceState) * frameRate;
+	std::printf("frames:      %d at %.0f/s, %llu keyframes, %llu deltas, %llu unchanged, %llu mismatched\n",
+		frameNum, frameRate, static_cast<unsigned long long>(counters.keyframes),
+		static_cast<unsigned long long>(counters.deltas), static_cast<unsigned long long>(emptyFrames),
+		static_cast<unsigned long long>(mismatches));
+	std::printf("size:        keyframe %.1f bytes, delta %.1f bytes, full state %zu bytes\n",
+		counters.keyframes ? static_cast<double>(keyframeBytes) / counters.keyframes : 0.0,
+		counters.deltas ? static_cast<double>(deltaBytes) / counters.deltas : 0.0, sizeof(SurfaceState));
+	std::printf("bandwidth:   %.0f bytes/s (%.0f%% keyframes), %.0f bytes/s sending the full state\n",
+		counters.bytes / seconds, counters.bytes ? 100.0 * keyframeBytes / counters.bytes : 0.0, rawBytesPerSecond);
+	std::printf("encode:      %.2f us per frame\n", encodeSeconds / frameNum * 1e6);
+	return mismatches ? 1 : 0;
+}
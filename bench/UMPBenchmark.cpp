@@ -0,0 +1,136 @@
+/*****************************************************************//**
+ * \file	UMPBenchmark.cpp
+ * \brief	Throughput of the Universal MIDI Packet encoder and decoder.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageUMP.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace mackieControl;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Host output of a busy session: faders, LEDs, V-Pot rings, meters and LCD updates.
+ */
+static std::vector<Message> createMessages(int messageNum) {
+	std::vector<Message> messages;
+	messages.reserve(messageNum);
+	char text[7];
+	for (int i = 0; i < messageNum; i++) {
+		int value = i / 5;
+		switch (i % 5) {
+		case 0:
+			messages.emplace_back(Message::createPitchWheel(1 + value % 9, (value * 37) % (1 << 14)));
+			break;
+		case 1:
+			messages.emplace_back(Message::createNote(validNoteMessage[value % validNoteMessage.size()],
+				(value & 1) ? VelocityMessage::On : VelocityMessage::Off));
+			break;
+		case 2:
+			messages.emplace_back(Message::createCC(static_cast<CCMessage>(static_cast<int>(CCMessage::VPotLEDRing1) + value % 8),
+				Message::toVPotLEDRingValue(false, VPotLEDRingMode::SingleDotMode, 1 + value % 11)));
+			break;
+		case 3:
+			messages.emplace_back(Message::createChannelPressure(1 + value % 8, value % 13));
+			break;
+		default:
+			for (int j = 0; j < 7; j++) {
+				text[j] = static_cast<char>('A' + (value + j) % 26);
+			}
+			messages.emplace_back(Message::createLCD(static_cast<uint8_t>((value % 16) * 7), text, 7));
+			break;
+		}
+	}
+	return messages;
+}
+
+static double getSeconds(Clock::time_point start) {
+	std::chrono::duration<double> time = Clock::now() - start;
+	return time.count();
+}
+
+/**
+ * Usage: UMPBenchmark [messageNum] [rounds]
+ */
+int main(int argc, char* argv[]) {
+	int messageNum = (argc > 1) ? std::atoi(argv[1]) : 100000;
+	int rounds = (argc > 2) ? std::atoi(argv[2]) : 20;
+	if (messageNum <= 0 || rounds <= 0) { return 1; }
+
+	auto messages = createMessages(messageNum);
+	UMPEncoder encoder;
+	UMPDecoder decoder;
+
+	uint64_t midiBytes = 0;
+	for (auto& message : messages) {
+		midiBytes += message.getRawDataSize();
+	}
+
+	//Encode
+	std::vector<uint32_t> words;
+	words.reserve(messageNum * 4);
+	double encodeSeconds = 0;
+	for (int round = 0; round < rounds; round++) {
+		words.clear();
+		auto start = Clock::now();
+		for (auto& message : messages) {
+			encoder.encode(message, words);
+		}
+		encodeSeconds += getSeconds(start);
+	}
+
+	//Decode
+	std::vector<Message> decoded;
+	decoded.reserve(messageNum);
+	double decodeSeconds = 0;
+	for (int round = 0; round < rounds; round++) {
+		decoded.clear();
+		auto start = Clock::now();
+		decoder.decode(words.data(), static_cast<int>(words.size()), decoded);
+		decodeSeconds += getSeconds(start);
+	}
+
+	uint64_t mismatches = (decoded.size() == messages.size()) ? 0 : 1;
+	for (std::size_t i = 0; !mismatches && i < messages.size(); i++) {
+		auto& a = messages[i];
+		auto& b = decoded[i];
+		mismatches += (a.getRawDataSize() != b.getRawDataSize()
+			|| !std::equal(a.getRawData(), a.getRawData() + a.getRawDataSize(), b.getRawData())) ? 1 : 0;
+	}
+
+	//LCD updates encoded directly against creating the message first
+	const char* text = "Volume";
+	std::vector<uint32_t> lcdWords;
+	lcdWords.reserve(messageNum * 4);
+	auto start = Clock::now();
+	for (int i = 0; i < messageNum; i++) {
+		encoder.encodeLCD(static_cast<uint8_t>((i % 8) * 7), text, 6, lcdWords);
+	}
+	double directSeconds = getSeconds(start);
+	lcdWords.clear();
+	start = Clock::now();
+	for (int i = 0; i < messageNum; i++) {
+		encoder.encode(Message::createLCD(static_cast<uint8_t>((i % 8) * 7), text, 6), lcdWords);
+	}
+	double createdSeconds = getSeconds(start);
+
+	double total = static_cast<double>(messageNum) * rounds;
+	std::printf("stream:      %d messages, %llu MIDI bytes, %zu UMP words\n",
+		messageNum, static_cast<unsigned long long>(midiBytes), words.size());
+	std::printf("encode:      %.0f messages/s, %.1f MB/s of UMP\n",
+		total / encodeSeconds, total / messageNum * words.size() * 4 / encodeSeconds / 1e6);
+	std::printf("decode:      %.0f messages/s, %.1f MB/s of UMP, %llu mismatched\n",
+		total / decodeSeconds, total / messageNum * words.size() * 4 / decodeSeconds / 1e6,
+		static_cast<unsigned long long>(mismatches));
+	std::printf("LCD:         %.0f/s encodeLCD, %.0f/s createLCD + encode\n",
+		messageNum / directSeconds, messageNum / createdSeconds);
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,269 @@
+/*****************************************************************//**
+ * \file	AutomationRecorder.cpp
+ * \brief	Automation write recording from fader and V-Pot input.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "AutomationRecorder.h"
+#include <algorithm>
+#include <limits>
+
+namespace mackieControl {
+	AutomationRecorder::AutomationRecorder(int stripNum)
+		: AutomationRecorder(stripNum, Config{}) {}
+
+	AutomationRecorder::AutomationRecorder(int stripNum, const Config& config)
+		: config(config), lanes(std::max(stripNum, 0)) {
+		this->config.chunkSize = std::max(this->config.chunkSize, 1);
+	}
+
+	bool AutomationRecorder::process(const Message& message, double timeMs, int device) {
+		int base = ChannelNum * device;
+
+		if (message.isNote()) {
+			auto [type, vel] = message.getNoteData();
+			int index = static_cast<int>(type) - static_cast<int>(NoteMessage::FaderTouchCh1);
+			if (index < 0 || index >= ChannelNum || !this->getLane(base + index, AutomationLane::Fader)) { return false; }
+
+			this->setTouched(base + index, vel != VelocityMessage::Off, timeMs);
+			return true;
+		}
+		if (message.isPitchWheel()) {
+			auto [channel, value] = message.getPitchWheelData();
+			int index = channel - 1;
+			if (index < 0 || index >= ChannelNum || !this->getLane(base + index, AutomationLane::Fader)) { return false; }
+
+			this->addFader(base + index, value, timeMs);
+			return true;
+		}
+		if (message.isCC()) {
+			auto [type, value] = message.getCCData();
+			int index = static_cast<int>(type) - static_cast<int>(CCMessage::VPot1);
+			if (index < 0 || index >= ChannelNum || !this->getLane(base + index, AutomationLane::VPot)) { return false; }
+
+			auto [direction, ticks] = Message::convertVPotValue(value);
+			this->addVPot(base + index, direction, ticks, timeMs);
+			return true;
+		}
+		return false;
+	}
+
+	void AutomationRecorder::addFader(int strip, int value, double timeMs) {
+		auto lane = this->getLane(strip, AutomationLane::Fader);
+		if (!lane) { return; }
+
+		lane->value = std::clamp(value / 16383.f, 0.f, 1.f);
+		lane->valueKnown = true;
+		if (this->config.requireTouch && !lane->touched) { return; }
+
+		this->add(*lane, this->config.faderTolerance, timeMs, lane->value);
+	}
+
+	void AutomationRecorder::addVPot(int strip, WheelType type, int ticks, double timeMs) {
+		auto lane = this->getLane(strip, AutomationLane::VPot);
+		if (!lane) { return; }
+
+		//Ticks are relative, so nothing is recorded until setValue() tells where the parameter is
+		if (!lane->valueKnown) { return; }
+
+		float delta = ticks * this->config.vPotStep;
+		lane->value = std::clamp(lane->value + ((type == WheelType::CW) ? delta : -delta), 0.f, 1.f);
+
+		this->add(*lane, this->config.vPotTolerance, timeMs, lane->value);
+	}
+
+	void AutomationRecorder::setTouched(int strip, bool touched, double timeMs) {
+		auto lane = this->getLane(strip, AutomationLane::Fader);
+		if (!lane || lane->touched == touched) { return; }
+
+		//A touch starts a new pass at the current position, a release ends it
+		this->end(*lane);
+		lane->touched = touched;
+		if (touched && lane->valueKnown) {
+			this->add(*lane, this->config.faderTolerance, timeMs, lane->value);
+		}
+	}
+
+	void AutomationRecorder::setValue(int strip, AutomationLane lane, float value) {
+		auto ptr = this->getLane(strip, lane);
+		if (!ptr) { return; }
+
+		ptr->value = std::clamp(value, 0.f, 1.f);
+		ptr->valueKnown = true;
+	}
+
+	void AutomationRecorder::advance(double timeMs) {
+		for (auto& strip : this->lanes) {
+			for (auto& lane : strip) {
+				if (lane.recording && !lane.touched && timeMs - lane.lastTime > this->config.idleMs) {
+					this->end(lane);
+				}
+			}
+		}
+	}
+
+	void AutomationRecorder::finish() {
+		for (auto& strip : this->lanes) {
+			for (auto& lane : strip) {
+				this->end(lane);
+			}
+		}
+	}
+
+	int AutomationRecorder::getPassNum(int strip, AutomationLane lane) const {
+		auto ptr = this->getLane(strip, lane);
+		return ptr ? static_cast<int>(ptr->passes.size()) : 0;
+	}
+
+	const AutomationRecorder::Pass* AutomationRecorder::getPass(int strip, AutomationLane lane, int pass) const {
+		auto ptr = this->getLane(strip, lane);
+		if (!ptr || pass < 0 || pass >= static_cast<int>(ptr->passes.size())) { return nullptr; }
+		return &(ptr->passes[pass]);
+	}
+
+	int AutomationRecorder::getPoints(int strip, AutomationLane lane, int pass, std::vector<AutomationPoint>& points) const {
+		auto ptr = this->getLane(strip, lane);
+		auto info = this->getPass(strip, lane, pass);
+		if (!ptr || !info) { return 0; }
+
+		int chunkSize = this->config.chunkSize;
+		for (int i = info->firstPoint; i < info->firstPoint + info->pointNum; i++) {
+			auto& point = ptr->chunks[i / chunkSize][i % chunkSize];
+			points.push_back({ info->startTime + point.offset, point.value });
+		}
+		return info->pointNum;
+	}
+
+	AutomationRecorder::Stats AutomationRecorder::getStats() const {
+		Stats stats;
+		stats.inputPoints = this->inputPoints;
+		stats.inputBytes = this->inputPoints * sizeof(AutomationPoint);
+
+		for (auto& strip : this->lanes) {
+			for (auto& lane : strip) {
+				stats.storedPoints += lane.pointNum;
+				stats.storedBytes += lane.pointNum * sizeof(StoredPoint) + lane.passes.size() * sizeof(Pass);
+				stats.reservedBytes += lane.chunks.size() * this->config.chunkSize * sizeof(StoredPoint)
+					+ lane.passes.capacity() * sizeof(Pass);
+			}
+		}
+		return stats;
+	}
+
+	int AutomationRecorder::getStripNum() const {
+		return static_cast<int>(this->lanes.size());
+	}
+
+	void AutomationRecorder::clear() {
+		this->finish();
+		for (auto& strip : this->lanes) {
+			for (auto& lane : strip) {
+				lane.chunks.clear();
+				lane.passes.clear();
+				lane.pointNum = 0;
+			}
+		}
+		this->inputPoints = 0;
+	}
+
+	AutomationRecorder::Lane* AutomationRecorder::getLane(int strip, AutomationLane lane) {
+		if (strip < 0 || strip >= this->getStripNum()) { return nullptr; }
+		return &(this->lanes[strip][static_cast<int>(lane) & 1]);
+	}
+
+	const AutomationRecorder::Lane* AutomationRecorder::getLane(int strip, AutomationLane lane) const {
+		if (strip < 0 || strip >= this->getStripNum()) { return nullptr; }
+		return &(this->lanes[strip][static_cast<int>(lane) & 1]);
+	}
+
+	void AutomationRecorder::add(Lane& lane, float tolerance, double timeMs, float value) {
+		this->inputPoints++;
+
+		if (lane.recording && !lane.touched && timeMs - lane.lastTime > this->config.idleMs) {
+			this->end(lane);
+		}
+		if (!lane.recording) {
+			this->begin(lane, timeMs);
+			this->store(lane, timeMs, value);
+			lane.anchorTime = lane.lastTime = timeMs;
+			lane.anchorValue = value;
+			lane.upperSlope = std::numeric_limits<double>::infinity();
+			lane.lowerSlope = -std::numeric_limits<double>::infinity();
+			return;
+		}
+
+		//Points with the same timestamp are spread out, so every slope is finite
+		timeMs = std::max(timeMs, lane.lastTime + 0.001);
+
+		double dt = timeMs - lane.anchorTime;
+		double upper = std::min(lane.upperSlope, (value + tolerance - lane.anchorValue) / dt);
+		double lower = std::max(lane.lowerSlope, (value - tolerance - lane.anchorValue) / dt);
+
+		if (lower > upper && lane.lastPending) {
+			//The door closed: the segment ends at the last point and the next one starts there
+			this->storeLast(lane);
+
+			dt = timeMs - lane.anchorTime;
+			upper = (value + tolerance - lane.anchorValue) / dt;
+			lower = (value - tolerance - lane.anchorValue) / dt;
+		}
+
+		lane.upperSlope = upper;
+		lane.lowerSlope = lower;
+		lane.lastTime = timeMs;
+		lane.lastPending = true;
+	}
+
+	void AutomationRecorder::begin(Lane& lane, double timeMs) {
+		Pass pass;
+		pass.startTime = timeMs;
+		pass.endTime = timeMs;
+		pass.firstPoint = lane.pointNum;
+		lane.passes.push_back(pass);
+
+		lane.recording = true;
+		lane.lastPending = false;
+	}
+
+	void AutomationRecorder::end(Lane& lane) {
+		if (!lane.recording) { return; }
+
+		if (lane.lastPending) {
+			this->storeLast(lane);
+		}
+		lane.passes.back().endTime = lane.lastTime;
+
+		lane.recording = false;
+		lane.lastPending = false;
+	}
+
+	void AutomationRecorder::store(Lane& lane, double timeMs, float value) {
+		int chunkSize = this->config.chunkSize;
+		if (lane.pointNum / chunkSize >= static_cast<int>(lane.chunks.size())) {
+			lane.chunks.push_back(std::make_unique<StoredPoint[]>(chunkSize));
+		}
+
+		auto& pass = lane.passes.back();
+		lane.chunks[lane.pointNum / chunkSize][lane.pointNum % chunkSize]
+			= { static_cast<float>(timeMs - pass.startTime), value };
+		lane.pointNum++;
+		pass.pointNum++;
+	}
+
+	void AutomationRecorder::storeLast(Lane& lane) {
+		//The segment takes a slope inside the door, which is within the tolerance of every point since the anchor,
+		//so its end is moved onto that line instead of being the last point itself
+		double slope = (lane.upperSlope + lane.lowerSlope) / 2;
+		float value = static_cast<float>(lane.anchorValue + slope * (lane.lastTime - lane.anchorTime));
+
+		this->store(lane, lane.lastTime, value);
+		lane.anchorTime = lane.lastTime;
+		lane.anchorValue = value;
+		lane.lastPending = false;
+	}
+}
@@ -0,0 +1,253 @@
+/*****************************************************************//**
+ * \file	AutomationRecorder.h
+ * \brief	Automation write recording from fader and V-Pot input.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#include <memory>
+
+namespace mackieControl {
+	/**
+	 * Automation lanes of a strip.
+	 */
+	enum class AutomationLane : uint8_t {
+		Fader,
+		VPot
+	};
+
+	/**
+	 * Automation point.
+	 */
+	struct AutomationPoint final {
+		/**
+		 * Time (ms).
+		 */
+		double time = 0;
+		/**
+		 * Value (0 to 1).
+		 */
+		float value = 0;
+	};
+
+	/**
+	 * Record automation from the fader and V-Pot input of many strips.
+	 * Input is thinned while it arrives by a swing door filter, the streaming form of Ramer-Douglas-Peucker
+	 * simplification: a point is only stored when the line from the last stored point can no longer pass within the
+	 * tolerance of every point since, so the stored curve never differs from the input by more than the tolerance.
+	 * Fader passes follow the fader touch and release; V-Pot passes end after the V-Pot is idle for a while.
+	 * Points are kept in per-lane arenas of fixed-size chunks, as 32-bit offsets from the start of their pass.
+	 */
+	class AutomationRecorder final {
+	public:
+		/**
+		 * Number of channel strips of each device.
+		 */
+		static constexpr int ChannelNum = 8;
+
+		/**
+		 * Recording parameters.
+		 */
+		struct Config final {
+			/**
+			 * Largest error of fader automation (in value).
+			 */
+			float faderTolerance = 1.f / 1024;
+			/**
+			 * Largest error of V-Pot automation (in value).
+			 */
+			float vPotTolerance = 1.f / 512;
+			/**
+			 * Value change of one V-Pot tick.
+			 */
+			float vPotStep = 1.f / 256;
+			/**
+			 * Idle time (ms) which ends a pass without touch.
+			 */
+			double idleMs = 500;
+			/**
+			 * Only record faders while they are touched. Disable for surfaces without touch sensing, so fader passes
+			 * end on idle like V-Pot passes.
+			 */
+			bool requireTouch = true;
+			/**
+			 * Number of points of each arena chunk.
+			 */
+			int chunkSize = 4096;
+		};
+
+		/**
+		 * Recorded pass of a lane.
+		 */
+		struct Pass final {
+			double startTime = 0;
+			double endTime = 0;
+			int firstPoint = 0;
+			int pointNum = 0;
+		};
+
+		/**
+		 * Point reduction and memory use.
+		 */
+		struct Stats final {
+			/**
+			 * Number of input points.
+			 */
+			uint64_t inputPoints = 0;
+			/**
+			 * Number of stored points.
+			 */
+			uint64_t storedPoints = 0;
+			/**
+			 * Bytes the input points would take as AutomationPoint.
+			 */
+			uint64_t inputBytes = 0;
+			/**
+			 * Bytes taken by the stored points and passes.
+			 */
+			uint64_t storedBytes = 0;
+			/**
+			 * Bytes allocated for the arenas and passes, including unused chunk and pass capacity.
+			 */
+			uint64_t reservedBytes = 0;
+		};
+
+		/**
+		 * Create a recorder with the default recording parameters.
+		 * \param stripNum		Number of Strips of All Devices
+		 */
+		explicit AutomationRecorder(int stripNum);
+		/**
+		 * Create a recorder.
+		 * \param stripNum		Number of Strips of All Devices
+		 * \param config		Recording Parameters
+		 */
+		AutomationRecorder(int stripNum, const Config& config);
+
+		/**
+		 * Record a message received from a surface. Pitch wheel, V-Pot and fader touch messages of strips are used.
+		 * \param message		Message
+		 * \param timeMs		Receive Time (ms)
+		 * \param device		Device Index, the strips of a device start at ChannelNum * device
+		 * \return	Whether the message was used.
+		 */
+		bool process(const Message& message, double timeMs, int device = 0);
+
+		/**
+		 * Record a fader position.
+		 * \param strip			Strip Index
+		 * \param value			Fader Value (0-16383)
+		 * \param timeMs		Time (ms)
+		 */
+		void addFader(int strip, int value, double timeMs);
+		/**
+		 * Record a V-Pot rotation. The value of the V-Pot lane moves by vPotStep each tick. Rotations are ignored until
+		 * the value of the lane is set by setValue().
+		 * \param strip			Strip Index
+		 * \param type			Rotation Direction
+		 * \param ticks			Rotation Ticks
+		 * \param timeMs		Time (ms)
+		 */
+		void addVPot(int strip, WheelType type, int ticks, double timeMs);
+		/**
+		 * Start or end the fader pass of a strip.
+		 * \param strip			Strip Index
+		 * \param touched		Touched/Released
+		 * \param timeMs		Time (ms)
+		 */
+		void setTouched(int strip, bool touched, double timeMs);
+		/**
+		 * Set the current value of a lane, such as the parameter value when a V-Pot pass starts.
+		 * \param strip			Strip Index
+		 * \param lane			Lane
+		 * \param value			Value (0 to 1)
+		 */
+		void setValue(int strip, AutomationLane lane, float value);
+
+		/**
+		 * End the passes which are idle at the time.
+		 * \param timeMs		Current Time (ms)
+		 */
+		void advance(double timeMs);
+		/**
+		 * End all passes.
+		 */
+		void finish();
+
+		/**
+		 * Get the number of recorded passes of a lane.
+		 */
+		int getPassNum(int strip, AutomationLane lane) const;
+		/**
+		 * Get a recorded pass of a lane.
+		 * \return	The pass, or nullptr if the index is out of range.
+		 */
+		const Pass* getPass(int strip, AutomationLane lane, int pass) const;
+		/**
+		 * Append the points of a recorded pass.
+		 * \param strip			Strip Index
+		 * \param lane			Lane
+		 * \param pass			Pass Index
+		 * \param points		Output Points
+		 * \return	Number of Points Appended
+		 */
+		int getPoints(int strip, AutomationLane lane, int pass, std::vector<AutomationPoint>& points) const;
+
+		/**
+		 * Get the point reduction and memory use.
+		 */
+		Stats getStats() const;
+		/**
+		 * Get the number of strips.
+		 */
+		int getStripNum() const;
+		/**
+		 * Remove all recorded passes. Passes in progress are ended first.
+		 */
+		void clear();
+
+	private:
+		struct StoredPoint final {
+			float offset;
+			float value;
+		};
+
+		struct Lane final {
+			std::vector<std::unique_ptr<StoredPoint[]>> chunks;
+			int pointNum = 0;
+			std::vector<Pass> passes;
+
+			float value = 0;
+			bool valueKnown = false;
+			bool recording = false;
+			bool touched = false;
+
+			//Swing door state: the anchor is the last stored point, the last point is held back until the door closes
+			double anchorTime = 0;
+			float anchorValue = 0;
+			double lastTime = 0;
+			bool lastPending = false;
+			double upperSlope = 0, lowerSlope = 0;
+		};
+
+		Config config;
+		std::vector<std::array<Lane, 2>> lanes;
+		uint64_t inputPoints = 0;
+
+		Lane* getLane(int strip, AutomationLane lane);
+		const Lane* getLane(int strip, AutomationLane lane) const;
+
+		void add(Lane& lane, float tolerance, double timeMs, float value);
+		void begin(Lane& lane, double timeMs);
+		void end(Lane& lane);
+		void storeLast(Lane& lane);
+		void store(Lane& lane, double timeMs, float value);
+	};
+}
@@ -0,0 +1,208 @@
+/*****************************************************************//**
+ * \file	ChordEngine.cpp
+ * \brief	Modifier and chord resolution of Mackie Control button input.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "ChordEngine.h"
+
+namespace mackieControl {
+	ChordEngine::ChordEngine(BindingCallback callback, double doublePressMs, double longPressMs)
+		: callback(std::move(callback)), doublePressMs(doublePressMs), longPressMs(longPressMs),
+		bindings(128 * ModifierNum * GestureNum, static_cast<int16_t>(NoBinding)) {}
+
+	bool ChordEngine::bind(NoteMessage button, ModifierFlags modifiers, GestureType gesture, int binding) {
+		if (binding < NoBinding || binding > INT16_MAX) { return false; }
+
+		this->bindings[ChordEngine::toIndex(static_cast<int>(button), static_cast<int>(modifiers), gesture)]
+			= static_cast<int16_t>(binding);
+		return true;
+	}
+
+	void ChordEngine::unbind(NoteMessage button, ModifierFlags modifiers, GestureType gesture) {
+		this->bind(button, modifiers, gesture, NoBinding);
+	}
+
+	int ChordEngine::getBinding(NoteMessage button, ModifierFlags modifiers, GestureType gesture) const {
+		return this->bindings[ChordEngine::toIndex(static_cast<int>(button), static_cast<int>(modifiers), gesture)];
+	}
+
+	bool ChordEngine::process(const Message& message, double timeMs) {
+		if (!message.isNote()) { return false; }
+
+		auto [button, vel] = message.getNoteData();
+		this->process(button, vel != VelocityMessage::Off, timeMs);
+		return true;
+	}
+
+	void ChordEngine::process(NoteMessage button, bool pressed, double timeMs) {
+		int index = static_cast<int>(button) & 127;
+		uint64_t bit = uint64_t{ 1 } << (index % 64);
+		bool wasHeld = this->held[index / 64] & bit;
+		if (pressed == wasHeld) { return; }
+
+		auto& timing = this->timings[index];
+
+		if (pressed) {
+			int modifiers = static_cast<int>(this->getModifiers());
+			this->held[index / 64] |= bit;
+
+			if (timing.secondPressPending) {
+				timing.secondPressPending = false;
+				if (timeMs - timing.pressTime <= this->doublePressMs && modifiers == timing.modifiers) {
+					//The first tap is part of the double press, so its held back press and release are dropped
+					timing.pressDeferred = false;
+					timing.releaseDeferred = false;
+					timing.consumed = true;
+					this->updateDeadline();
+					this->trigger(index, modifiers, GestureType::DoublePress);
+					return;
+				}
+				this->resolveDeferred(index);
+			}
+
+			timing.pressTime = timeMs;
+			timing.modifiers = static_cast<uint8_t>(modifiers);
+			timing.consumed = false;
+
+			bool hasDouble = this->hasBinding(index, modifiers, GestureType::DoublePress);
+			bool hasLong = this->hasBinding(index, modifiers, GestureType::LongPress);
+			if (hasDouble || hasLong) {
+				//The press is resolved later, once it is known not to be another gesture
+				timing.pressDeferred = true;
+				timing.longPressPending = hasLong;
+				if (hasLong) { this->addPending(index); }
+			}
+			else {
+				this->trigger(index, modifiers, GestureType::Press);
+			}
+			return;
+		}
+
+		this->held[index / 64] &= ~bit;
+		timing.longPressPending = false;
+
+		//A tap consumed by a long press or double press delivers neither its press nor its release
+		if (timing.consumed) {
+			this->updateDeadline();
+			return;
+		}
+
+		//A release is never delivered before the press it belongs to
+		if (timing.pressDeferred) {
+			if (this->hasBinding(index, timing.modifiers, GestureType::DoublePress)) {
+				timing.secondPressPending = true;
+				timing.releaseDeferred = true;
+				this->addPending(index);
+				return;
+			}
+			timing.pressDeferred = false;
+			this->trigger(index, timing.modifiers, GestureType::Press);
+		}
+		this->updateDeadline();
+		this->trigger(index, timing.modifiers, GestureType::Release);
+	}
+
+	void ChordEngine::advance(double timeMs) {
+		if (this->nextDeadline < 0 || timeMs < this->nextDeadline) { return; }
+
+		//Triggered callbacks may process new events, so work on a copy of the pending list
+		auto buttons = this->pending;
+		for (int index : buttons) {
+			auto& timing = this->timings[index];
+
+			if (timing.longPressPending && timeMs >= timing.pressTime + this->longPressMs) {
+				timing.longPressPending = false;
+				timing.pressDeferred = false;
+				timing.consumed = true;
+				this->trigger(index, timing.modifiers, GestureType::LongPress);
+			}
+			if (timing.secondPressPending && timeMs >= timing.pressTime + this->doublePressMs) {
+				timing.secondPressPending = false;
+				this->resolveDeferred(index);
+			}
+		}
+
+		this->updateDeadline();
+	}
+
+	double ChordEngine::getNextDeadline() const {
+		return this->nextDeadline;
+	}
+
+	bool ChordEngine::isHeld(NoteMessage button) const {
+		int index = static_cast<int>(button) & 127;
+		return (this->held[index / 64] >> (index % 64)) & 1;
+	}
+
+	ModifierFlags ChordEngine::getModifiers() const {
+		//SHIFT, OPTION, CONTROL and CMDALT are consecutive notes
+		constexpr int first = static_cast<int>(NoteMessage::SHIFT);
+		static_assert(static_cast<int>(NoteMessage::CMDALT) == first + 3 && first / 64 == (first + 3) / 64);
+		return static_cast<ModifierFlags>((this->held[first / 64] >> (first % 64)) & 0x0F);
+	}
+
+	void ChordEngine::reset() {
+		this->held.fill(0);
+		this->timings.fill(ButtonTiming{});
+		this->pending.clear();
+		this->nextDeadline = -1;
+	}
+
+	int ChordEngine::toIndex(int button, int modifiers, GestureType gesture) {
+		return ((button & 127) * ModifierNum + (modifiers & (ModifierNum - 1))) * GestureNum + static_cast<int>(gesture);
+	}
+
+	void ChordEngine::trigger(int button, int modifiers, GestureType gesture) {
+		int binding = this->bindings[ChordEngine::toIndex(button, modifiers, gesture)];
+		if (binding != NoBinding && this->callback) {
+			this->callback(binding);
+		}
+	}
+
+	void ChordEngine::resolveDeferred(int button) {
+		auto& timing = this->timings[button];
+		if (timing.pressDeferred) {
+			timing.pressDeferred = false;
+			this->trigger(button, timing.modifiers, GestureType::Press);
+		}
+		if (timing.releaseDeferred) {
+			timing.releaseDeferred = false;
+			this->trigger(button, timing.modifiers, GestureType::Release);
+		}
+	}
+
+	void ChordEngine::addPending(int button) {
+		if (std::find(this->pending.begin(), this->pending.end(), button) == this->pending.end()) {
+			this->pending.push_back(static_cast<uint8_t>(button));
+		}
+		this->updateDeadline();
+	}
+
+	void ChordEngine::updateDeadline() {
+		this->nextDeadline = -1;
+		std::erase_if(this->pending, [this](uint8_t index) {
+			auto& timing = this->timings[index];
+			return !timing.longPressPending && !timing.secondPressPending;
+			});
+
+		for (int index : this->pending) {
+			auto& timing = this->timings[index];
+			double deadline = timing.longPressPending
+				? timing.pressTime + this->longPressMs
+				: timing.pressTime + this->doublePressMs;
+			if (this->nextDeadline < 0 || deadline < this->nextDeadline) {
+				this->nextDeadline = deadline;
+			}
+		}
+	}
+
+	bool ChordEngine::hasBinding(int button, int modifiers, GestureType gesture) const {
+		return this->bindings[ChordEngine::toIndex(button, modifiers, gesture)] != NoBinding;
+	}
+}
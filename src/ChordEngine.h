@@ -0,0 +1,153 @@
+/*****************************************************************//**
+ * \file	ChordEngine.h
+ * \brief	Modifier and chord resolution of Mackie Control button input.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#include <functional>
+
+namespace mackieControl {
+	/**
+	 * Modifier buttons as bit mask.
+	 */
+	enum class ModifierFlags : uint8_t {
+		None = 0,
+		Shift = 1 << 0,
+		Option = 1 << 1,
+		Control = 1 << 2,
+		CmdAlt = 1 << 3
+	};
+
+	/**
+	 * Gestures a binding can be triggered by.
+	 * Press and Release of a button with a DoublePress or LongPress binding are held back until the gesture is ruled
+	 * out. A triggered LongPress or DoublePress consumes the tap, so neither Press nor Release of it is delivered.
+	 */
+	enum class GestureType : uint8_t {
+		Press,
+		Release,
+		DoublePress,
+		LongPress
+	};
+
+	/**
+	 * Resolve button input into bindings of modifiers + button and gestures.
+	 * Held buttons are kept as a 128-bit set, and bindings are resolved by one lookup in a dense table indexed by
+	 * button, modifier mask and gesture. Timed gestures (double press, long press) are driven by one coalesced timer:
+	 * call advance() from a single timer and it handles every pending deadline.
+	 */
+	class ChordEngine final {
+	public:
+		/**
+		 * Called when a binding is triggered.
+		 */
+		using BindingCallback = std::function<void(int binding)>;
+
+		/**
+		 * No binding.
+		 */
+		static constexpr int NoBinding = -1;
+
+		/**
+		 * Create an engine.
+		 * \param callback			Binding Callback
+		 * \param doublePressMs		Maximum Time between Presses of a Double Press (ms)
+		 * \param longPressMs		Minimum Hold Time of a Long Press (ms)
+		 */
+		explicit ChordEngine(BindingCallback callback, double doublePressMs = 300, double longPressMs = 500);
+
+		/**
+		 * Bind a gesture of a button with modifiers.
+		 * \param button		Button
+		 * \param modifiers		Modifier Mask
+		 * \param gesture		Gesture
+		 * \param binding		Binding ID (0-32767)
+		 * \return	Whether the binding was set. Binding IDs out of range are rejected.
+		 */
+		bool bind(NoteMessage button, ModifierFlags modifiers, GestureType gesture, int binding);
+		/**
+		 * Remove a binding.
+		 */
+		void unbind(NoteMessage button, ModifierFlags modifiers, GestureType gesture);
+		/**
+		 * Get the binding of a gesture.
+		 * \return	Binding ID, or NoBinding.
+		 */
+		int getBinding(NoteMessage button, ModifierFlags modifiers, GestureType gesture) const;
+
+		/**
+		 * Process a message received from the surface. Non-note messages are ignored.
+		 * \param message		Message
+		 * \param timeMs		Receive Time (ms)
+		 * \return	Whether the message is a note message.
+		 */
+		bool process(const Message& message, double timeMs);
+		/**
+		 * Process a button event.
+		 * \param button		Button
+		 * \param pressed		Pressed/Released
+		 * \param timeMs		Event Time (ms)
+		 */
+		void process(NoteMessage button, bool pressed, double timeMs);
+		/**
+		 * Trigger all timed gestures due at the time.
+		 * \param timeMs		Current Time (ms)
+		 */
+		void advance(double timeMs);
+		/**
+		 * Get the time of the next timed gesture deadline.
+		 * \return	Deadline (ms), or a negative value if nothing is pending.
+		 */
+		double getNextDeadline() const;
+
+		/**
+		 * Check if a button is held.
+		 */
+		bool isHeld(NoteMessage button) const;
+		/**
+		 * Get the current modifier mask.
+		 */
+		ModifierFlags getModifiers() const;
+		/**
+		 * Release all held buttons without triggering anything.
+		 */
+		void reset();
+
+	private:
+		static constexpr int GestureNum = 4;
+		static constexpr int ModifierNum = 16;
+
+		struct ButtonTiming final {
+			double pressTime = 0;
+			uint8_t modifiers = 0;
+			bool pressDeferred = false;
+			bool releaseDeferred = false;
+			bool longPressPending = false;
+			bool secondPressPending = false;
+			bool consumed = false;
+		};
+
+		BindingCallback callback;
+		double doublePressMs, longPressMs;
+		std::array<uint64_t, 2> held = {};
+		std::vector<int16_t> bindings;
+		std::array<ButtonTiming, 128> timings;
+		std::vector<uint8_t> pending;
+		double nextDeadline = -1;
+
+		static int toIndex(int button, int modifiers, GestureType gesture);
+		void trigger(int button, int modifiers, GestureType gesture);
+		void resolveDeferred(int button);
+		void addPending(int button);
+		void updateDeadline();
+		bool hasBinding(int button, int modifiers, GestureType gesture) const;
+	};
+}
@@ -0,0 +1,283 @@
+/*****************************************************************//**
+ * \file	Dialect.h
+ * \brief	Protocol dialect profiles of DAW-specific Mackie Control variants.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#include <initializer_list>
+
+namespace mackieControl {
+	/**
+	 * Table of the differences between Mackie Control variants: note and controller numbers on the wire and meter
+	 * scaling.
+	 * Tables are built at compile time by createDialectTable().
+	 */
+	struct DialectTable final {
+		/**
+		 * Unmapped entry.
+		 */
+		static constexpr uint8_t Invalid = 0xFF;
+
+		const char* name;
+		/**
+		 * Wire note number, indexed by NoteMessage.
+		 */
+		std::array<uint8_t, 128> noteToWire;
+		/**
+		 * NoteMessage, indexed by wire note number.
+		 */
+		std::array<uint8_t, 128> wireToNote;
+		/**
+		 * Wire controller number, indexed by CCMessage.
+		 */
+		std::array<uint8_t, 128> CCToWire;
+		/**
+		 * CCMessage, indexed by wire controller number.
+		 */
+		std::array<uint8_t, 128> wireToCC;
+		/**
+		 * Meter value of full scale (1-15).
+		 */
+		uint8_t meterMax;
+	};
+
+	/**
+	 * Note number of a NoteMessage in a dialect.
+	 */
+	struct NoteRemap final {
+		NoteMessage type;
+		uint8_t note;
+	};
+
+	/**
+	 * Controller number of a CCMessage in a dialect.
+	 */
+	struct CCRemap final {
+		CCMessage type;
+		uint8_t controller;
+	};
+
+	/**
+	 * Create a dialect table based on the mapping in doc/MackieControl.md.
+	 * Every wire number may only be used once: a remap onto the number of another message must remap that message
+	 * too. A collision or a meter value of full scale outside 1-15 throws, which fails the build when the table is a
+	 * constexpr variable.
+	 * \param name				Dialect Name
+	 * \param notes				Remapped Notes
+	 * \param CCs				Remapped Controllers
+	 * \param meterMax			Meter Value of Full Scale (1-15)
+	 */
+	constexpr DialectTable createDialectTable(const char* name,
+		std::initializer_list<NoteRemap> notes = {}, std::initializer_list<CCRemap> CCs = {},
+		uint8_t meterMax = 12) {
+		//The meter value shares the channel pressure byte with the channel, and is divided by in convertMeterValue()
+		if (meterMax < 1 || meterMax > 15) {
+			throw "createDialectTable: meter value of full scale out of 1-15";
+		}
+
+		DialectTable table{ name, {}, {}, {}, {}, meterMax };
+		table.noteToWire.fill(DialectTable::Invalid);
+		table.wireToNote.fill(DialectTable::Invalid);
+		table.CCToWire.fill(DialectTable::Invalid);
+		table.wireToCC.fill(DialectTable::Invalid);
+
+		for (auto mes : validNoteMessage) {
+			table.noteToWire[static_cast<int>(mes)] = static_cast<uint8_t>(mes);
+		}
+		for (auto remap : notes) {
+			table.noteToWire[static_cast<int>(remap.type) & 127] = remap.note & 127;
+		}
+		for (int i = 0; i < 128; i++) {
+			if (table.noteToWire[i] != DialectTable::Invalid) {
+				if (table.wireToNote[table.noteToWire[i]] != DialectTable::Invalid) {
+					throw "createDialectTable: two notes on the same wire note number";
+				}
+				table.wireToNote[table.noteToWire[i]] = static_cast<uint8_t>(i);
+			}
+		}
+
+		for (auto mes : validCCMessage) {
+			table.CCToWire[static_cast<int>(mes)] = static_cast<uint8_t>(mes);
+		}
+		for (auto remap : CCs) {
+			table.CCToWire[static_cast<int>(remap.type) & 127] = remap.controller & 127;
+		}
+		for (int i = 0; i < 128; i++) {
+			if (table.CCToWire[i] != DialectTable::Invalid) {
+				if (table.wireToCC[table.CCToWire[i]] != DialectTable::Invalid) {
+					throw "createDialectTable: two controllers on the same wire controller number";
+				}
+				table.wireToCC[table.CCToWire[i]] = static_cast<uint8_t>(i);
+			}
+		}
+
+		return table;
+	}
+
+	/**
+	 * The mapping used by Logic, which is the mapping of doc/MackieControl.md.
+	 */
+	inline constexpr DialectTable LogicDialect = createDialectTable("Logic");
+
+	/**
+	 * Encoder and decoder of the dialect dependent messages, selected at runtime by one table pointer.
+	 * Each message costs one table lookup; there is no branch on the dialect.
+	 */
+	class DialectCodec final {
+	public:
+		/**
+		 * Create a codec.
+		 * \param table			Dialect Table
+		 */
+		constexpr explicit DialectCodec(const DialectTable& table = LogicDialect)
+			: table(&table) {}
+
+		/**
+		 * Create a Mackie Control message via MIDI note message.
+		 * \param type			Message Type
+		 * \param vel			Message On/Off Type
+		 * \return	The message, or an empty message if the dialect has no such note.
+		 */
+		Message createNote(NoteMessage type, VelocityMessage vel) const {
+			uint8_t note = this->table->noteToWire[static_cast<int>(type) & 127];
+			if (note == DialectTable::Invalid) { return Message{}; }
+			return Message::createNote(static_cast<NoteMessage>(note), vel);
+		}
+		/**
+		 * Create a Mackie Control message via MIDI controller message.
+		 * \param type			Message Type
+		 * \param value			Value
+		 * \return	The message, or an empty message if the dialect has no such controller.
+		 */
+		Message createCC(CCMessage type, int value) const {
+			uint8_t controller = this->table->CCToWire[static_cast<int>(type) & 127];
+			if (controller == DialectTable::Invalid) { return Message{}; }
+			return Message::createCC(static_cast<CCMessage>(controller), value);
+		}
+		/**
+		 * Create a meter message scaled by the dialect.
+		 * \param channel		Meter Channel Number
+		 * \param level			Meter Level (0 to 1)
+		 */
+		Message createMeter(int channel, float level) const {
+			return Message::createChannelPressure(channel, this->toMeterValue(level));
+		}
+
+		/**
+		 * Check if the message is a note message of this dialect. The note number is checked by the dialect table
+		 * instead of the default validity table.
+		 */
+		bool isNote(const Message& message) const {
+			auto data = message.getRawData();
+			if (message.getRawDataSize() < 3 || (data[0] & 0xE0) != 0x80) { return false; }
+			return this->table->wireToNote[data[1] & 127] != DialectTable::Invalid && isValidVelocityMessage(data[2]);
+		}
+		/**
+		 * Check if the message is a controller message of this dialect. The controller number is checked by the dialect
+		 * table instead of the default validity table.
+		 */
+		bool isCC(const Message& message) const {
+			auto data = message.getRawData();
+			if (message.getRawDataSize() < 3 || (data[0] & 0xF0) != 0xB0) { return false; }
+			return this->table->wireToCC[data[1] & 127] != DialectTable::Invalid;
+		}
+
+		/**
+		 * Get the type of Mackie Control message via MIDI note message.
+		 * \return	Message Type, Message On/Off Type
+		 */
+		std::tuple<NoteMessage, VelocityMessage> getNoteData(const Message& message) const {
+			auto [note, vel] = message.getNoteData();
+			return { static_cast<NoteMessage>(this->table->wireToNote[static_cast<int>(note) & 127]), vel };
+		}
+		/**
+		 * Get the type of Mackie Control message via MIDI controller message.
+		 * \return	Message Type, Value
+		 */
+		std::tuple<CCMessage, int> getCCData(const Message& message) const {
+			auto [controller, value] = message.getCCData();
+			return { static_cast<CCMessage>(this->table->wireToCC[static_cast<int>(controller) & 127]), value };
+		}
+
+		/**
+		 * Convert meter level to meter value.
+		 * \param level			Meter Level (0 to 1)
+		 */
+		int toMeterValue(float level) const {
+			float value = std::clamp(level, 0.f, 1.f) * this->table->meterMax;
+			return static_cast<int>(value + 0.5f);
+		}
+		/**
+		 * Convert meter value to meter level.
+		 * \return	Meter Level (0 to 1)
+		 */
+		float convertMeterValue(int value) const {
+			return std::clamp(static_cast<float>(value) / this->table->meterMax, 0.f, 1.f);
+		}
+
+		/**
+		 * Get the dialect table.
+		 */
+		const DialectTable& getTable() const {
+			return *(this->table);
+		}
+
+	private:
+		const DialectTable* table;
+	};
+
+	/**
+	 * Dialect codec selected at compile time. All lookups are into a constant table and can be folded by the compiler.
+	 * \code
+	 * using Logic = StaticDialectCodec<LogicDialect>;
+	 * auto message = Logic::createNote(NoteMessage::PLAY, VelocityMessage::On);
+	 * \endcode
+	 */
+	template <const DialectTable& Table>
+	class StaticDialectCodec final {
+	public:
+		StaticDialectCodec() = delete;
+
+		static Message createNote(NoteMessage type, VelocityMessage vel) {
+			return StaticDialectCodec::codec.createNote(type, vel);
+		}
+		static Message createCC(CCMessage type, int value) {
+			return StaticDialectCodec::codec.createCC(type, value);
+		}
+		static Message createMeter(int channel, float level) {
+			return StaticDialectCodec::codec.createMeter(channel, level);
+		}
+		static bool isNote(const Message& message) {
+			return StaticDialectCodec::codec.isNote(message);
+		}
+		static bool isCC(const Message& message) {
+			return StaticDialectCodec::codec.isCC(message);
+		}
+		static std::tuple<NoteMessage, VelocityMessage> getNoteData(const Message& message) {
+			return StaticDialectCodec::codec.getNoteData(message);
+		}
+		static std::tuple<CCMessage, int> getCCData(const Message& message) {
+			return StaticDialectCodec::codec.getCCData(message);
+		}
+		static int toMeterValue(float level) {
+			return StaticDialectCodec::codec.toMeterValue(level);
+		}
+		static float convertMeterValue(int value) {
+			return StaticDialectCodec::codec.convertMeterValue(value);
+		}
+		static constexpr const DialectTable& getTable() {
+			return Table;
+		}
+
+	private:
+		static constexpr DialectCodec codec{ Table };
+	};
+}
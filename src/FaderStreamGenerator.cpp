@@ -0,0 +1,161 @@
+/*****************************************************************//**
+ * \file	FaderStreamGenerator.cpp
+ * \brief	Motor fader output stream of automation playback.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "FaderStreamGenerator.h"
+#include <cmath>
+
+namespace mackieControl {
+	FaderStreamGenerator::FaderStreamGenerator(double sampleRate)
+		: FaderStreamGenerator(sampleRate, Config{}) {}
+
+	FaderStreamGenerator::FaderStreamGenerator(double sampleRate, const Config& config)
+		: sampleRate(sampleRate), config(config) {
+		this->updateInterval();
+	}
+
+	int FaderStreamGenerator::process(int channel, const float* values, int numSamples, int64_t blockStart, MessageScheduler& scheduler) {
+		if (!values) { return 0; }
+		return this->processStrip(channel, [values](int offset) { return values[offset]; },
+			numSamples, blockStart, scheduler);
+	}
+
+	int FaderStreamGenerator::process(int channel, float value, int numSamples, int64_t blockStart, MessageScheduler& scheduler) {
+		return this->processStrip(channel, [value](int) { return value; },
+			numSamples, blockStart, scheduler);
+	}
+
+	void FaderStreamGenerator::setTouched(int channel, bool touched) {
+		if (channel < 1 || channel > FaderNum) { return; }
+		this->strips[channel - 1].touched = touched;
+	}
+
+	void FaderStreamGenerator::setPosition(int channel, int value) {
+		if (channel < 1 || channel > FaderNum) { return; }
+
+		auto& strip = this->strips[channel - 1];
+		strip.sent = std::clamp(value, 0, FaderMax);
+		strip.motor = strip.sent;
+		strip.direction = 0;
+	}
+
+	int FaderStreamGenerator::getPosition(int channel) const {
+		if (channel < 1 || channel > FaderNum) { return -1; }
+		return this->strips[channel - 1].sent;
+	}
+
+	void FaderStreamGenerator::setSampleRate(double sampleRate) {
+		this->sampleRate = sampleRate;
+		this->updateInterval();
+	}
+
+	void FaderStreamGenerator::setConfig(const Config& config) {
+		this->config = config;
+		this->updateInterval();
+	}
+
+	const FaderStreamGenerator::Config& FaderStreamGenerator::getConfig() const {
+		return this->config;
+	}
+
+	const FaderStreamGenerator::Counters& FaderStreamGenerator::getCounters() const {
+		return this->counters;
+	}
+
+	void FaderStreamGenerator::resetCounters() {
+		this->counters = Counters{};
+	}
+
+	void FaderStreamGenerator::reset() {
+		for (auto& strip : this->strips) {
+			bool touched = strip.touched;
+			strip = Strip{};
+			strip.touched = touched;
+		}
+	}
+
+	void FaderStreamGenerator::updateInterval() {
+		double rate = std::max(this->config.updateRate, 1.0);
+		this->interval = std::max(this->sampleRate / rate, 1.0);
+		this->motorStep = std::max(this->config.motorSpeed, 0.0) * FaderMax / rate;
+	}
+
+	bool FaderStreamGenerator::update(Strip& strip, int target) {
+		//Move the predicted motor position towards the last sent position
+		if (strip.motor >= 0 && strip.sent >= 0) {
+			double distance = strip.sent - strip.motor;
+			strip.motor = std::abs(distance) <= this->motorStep
+				? strip.sent : strip.motor + std::copysign(this->motorStep, distance);
+		}
+
+		//A target which stopped changing is the final position, so it is not held back by the hysteresis
+		bool settled = (target == strip.target);
+		strip.target = target;
+
+		if (strip.sent < 0) {
+			strip.sent = target;
+			if (strip.motor < 0) { strip.motor = target; }
+			this->counters.sent++;
+			return true;
+		}
+
+		int distance = target - strip.sent;
+		if (std::abs(distance) <= this->config.deadband) {
+			this->counters.skippedDeadband++;
+			return false;
+		}
+
+		int direction = distance > 0 ? 1 : -1;
+		if (!settled && strip.direction != 0 && direction != strip.direction
+			&& std::abs(distance) <= this->config.hysteresis) {
+			this->counters.skippedHysteresis++;
+			return false;
+		}
+
+		//The motor is still on its way to the last position, so a further one in the same direction changes nothing yet
+		if (this->motorStep > 0 && direction == strip.direction
+			&& std::abs(strip.sent - strip.motor) > this->motorStep) {
+			this->counters.skippedTravel++;
+			return false;
+		}
+
+		strip.sent = target;
+		strip.direction = direction;
+		this->counters.sent++;
+		return true;
+	}
+
+	template <typename ValueGetter>
+	int FaderStreamGenerator::processStrip(int channel, ValueGetter&& getValue, int numSamples, int64_t blockStart, MessageScheduler& scheduler) {
+		if (channel < 1 || channel > FaderNum || numSamples <= 0) { return 0; }
+
+		auto& strip = this->strips[channel - 1];
+		int count = 0;
+
+		double time = strip.phase;
+		for (; time < numSamples; time += this->interval) {
+			int offset = static_cast<int>(time);
+			if (strip.touched) { continue; }
+
+			//A NaN sample holds the last sent position, std::clamp would let it through
+			float value = getValue(offset);
+			if (std::isnan(value)) { continue; }
+			value = std::clamp(value, 0.f, 1.f);
+			int target = static_cast<int>(value * FaderMax + 0.5f);
+			if (this->update(strip, target)) {
+				scheduler.add(Message::createPitchWheel(channel, target), blockStart + offset);
+				count++;
+			}
+		}
+		strip.phase = time - numSamples;
+
+		return count;
+	}
+}
@@ -0,0 +1,168 @@
+/*****************************************************************//**
+ * \file	FaderStreamGenerator.h
+ * \brief	Motor fader output stream of automation playback.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MessageScheduler.h"
+
+namespace mackieControl {
+	/**
+	 * Turn audio rate automation values into motor fader pitch wheel messages.
+	 * Each strip is resampled to the motor update rate, and a position is sent only when it changes what the user
+	 * sees: moves inside the deadband are dropped, a change of direction has to exceed the hysteresis unless the value
+	 * has stopped changing, and while the motor is predicted to still be travelling towards the last position, further
+	 * positions in the same direction are held back until the motor can act on them.
+	 */
+	class FaderStreamGenerator final {
+	public:
+		/**
+		 * Number of faders, including the master fader.
+		 */
+		static constexpr int FaderNum = 9;
+		/**
+		 * Maximum fader value.
+		 */
+		static constexpr int FaderMax = 16383;
+
+		/**
+		 * Output shaping parameters.
+		 */
+		struct Config final {
+			/**
+			 * Motor update rate (Hz).
+			 */
+			double updateRate = 100;
+			/**
+			 * Smallest change sent (in fader value).
+			 */
+			int deadband = 16;
+			/**
+			 * Smallest change sent against the direction of the last move while the value is still moving (in fader value).
+			 */
+			int hysteresis = 64;
+			/**
+			 * Motor travel speed (full scale per second). 0 to disable travel prediction.
+			 */
+			double motorSpeed = 8;
+		};
+
+		/**
+		 * Counters of fader positions.
+		 */
+		struct Counters final {
+			uint64_t sent = 0;
+			uint64_t skippedDeadband = 0;
+			uint64_t skippedHysteresis = 0;
+			uint64_t skippedTravel = 0;
+		};
+
+		/**
+		 * Create a generator with the default output shaping parameters.
+		 * \param sampleRate	Audio Sample Rate
+		 */
+		explicit FaderStreamGenerator(double sampleRate);
+		/**
+		 * Create a generator.
+		 * \param sampleRate	Audio Sample Rate
+		 * \param config		Output Shaping Parameters
+		 */
+		FaderStreamGenerator(double sampleRate, const Config& config);
+
+		/**
+		 * Process a block of automation values of a strip.
+		 * \param channel		Fader Channel Number (1-9)
+		 * \param values		Automation Values (0 to 1, NaN holds the fader) of Each Sample
+		 * \param numSamples	Block Size
+		 * \param blockStart	Absolute Sample Time of the Block
+		 * \param scheduler		Output Scheduler
+		 * \return	Number of Messages Sent
+		 */
+		int process(int channel, const float* values, int numSamples, int64_t blockStart, MessageScheduler& scheduler);
+		/**
+		 * Process a block of constant automation value of a strip.
+		 * \param channel		Fader Channel Number (1-9)
+		 * \param value			Automation Value (0 to 1)
+		 * \param numSamples	Block Size
+		 * \param blockStart	Absolute Sample Time of the Block
+		 * \param scheduler		Output Scheduler
+		 * \return	Number of Messages Sent
+		 */
+		int process(int channel, float value, int numSamples, int64_t blockStart, MessageScheduler& scheduler);
+
+		/**
+		 * Set whether the fader is touched. Nothing is sent to a touched fader, and the position is taken over from
+		 * the surface.
+		 * \param channel		Fader Channel Number (1-9)
+		 * \param touched		Touched
+		 */
+		void setTouched(int channel, bool touched);
+		/**
+		 * Update the known position of a fader, such as from a fader move of the surface.
+		 * \param channel		Fader Channel Number (1-9)
+		 * \param value			Fader Value
+		 */
+		void setPosition(int channel, int value);
+		/**
+		 * Get the last position sent to a fader.
+		 * \param channel		Fader Channel Number (1-9)
+		 * \return	Fader Value, or -1 if nothing has been sent.
+		 */
+		int getPosition(int channel) const;
+
+		/**
+		 * Set the audio sample rate.
+		 */
+		void setSampleRate(double sampleRate);
+		/**
+		 * Set the output shaping parameters.
+		 */
+		void setConfig(const Config& config);
+		/**
+		 * Get the output shaping parameters.
+		 */
+		const Config& getConfig() const;
+
+		/**
+		 * Get the counters.
+		 */
+		const Counters& getCounters() const;
+		/**
+		 * Reset the counters.
+		 */
+		void resetCounters();
+		/**
+		 * Forget all fader positions, so the next update of each fader is sent.
+		 */
+		void reset();
+
+	private:
+		struct Strip final {
+			double phase = 0;
+			double motor = -1;
+			int sent = -1;
+			int target = -1;
+			int direction = 0;
+			bool touched = false;
+		};
+
+		double sampleRate;
+		Config config;
+		double interval = 0;
+		double motorStep = 0;
+		std::array<Strip, FaderNum> strips;
+		Counters counters;
+
+		void updateInterval();
+		bool update(Strip& strip, int target);
+		template <typename ValueGetter>
+		int processStrip(int channel, ValueGetter&& getValue, int numSamples, int64_t blockStart, MessageScheduler& scheduler);
+	};
+}
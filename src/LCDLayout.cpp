@@ -0,0 +1,287 @@
+/*****************************************************************//**
+ * \file	LCDLayout.cpp
+ * \brief	Per-strip text layout of the Mackie Control LCD.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "LCDLayout.h"
+#include <cmath>
+
+namespace mackieControl {
+	static bool hasRule(AbbreviationRule rules, AbbreviationRule rule) {
+		return (static_cast<uint8_t>(rules) & static_cast<uint8_t>(rule)) != 0;
+	}
+
+	static bool isSeparator(char c) {
+		return c == ' ' || c == '-' || c == '_' || c == '.';
+	}
+
+	static bool isLowerVowel(char c) {
+		return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
+	}
+
+	static bool isDigit(char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	static std::string_view trim(std::string_view text) {
+		while (!text.empty() && isSeparator(text.front())) { text.remove_prefix(1); }
+		while (!text.empty() && isSeparator(text.back())) { text.remove_suffix(1); }
+		return text;
+	}
+
+	static uint64_t hashText(std::string_view text) {
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : text) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static int writeInt(char* output, int value) {
+		char digits[10];
+		int size = 0;
+		do {
+			digits[size++] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value > 0 && size < static_cast<int>(sizeof(digits)));
+
+		for (int i = 0; i < size; i++) {
+			output[i] = digits[size - 1 - i];
+		}
+		return size;
+	}
+
+	LCDLayout::LCDLayout(AbbreviationRule rules, int cacheSize)
+		: rules(rules) {
+		int size = 1;
+		while (size < cacheSize) { size <<= 1; }
+		this->cache.resize(size);
+
+		this->clear();
+		this->invalidate();
+	}
+
+	void LCDLayout::setText(bool lowerLine, int strip, std::string_view text) {
+		this->writeCell(lowerLine, strip, this->lookup(text));
+	}
+
+	void LCDLayout::setDecibels(bool lowerLine, int strip, float decibels) {
+		if (!(decibels > -100.f)) {
+			this->writeValue(lowerLine, strip, "-inf", 4);
+			return;
+		}
+
+		char data[16];
+		int size = 0;
+		int tenths = static_cast<int>(std::lround(std::min(decibels, 999.f) * 10));
+		if (tenths != 0) { data[size++] = (tenths < 0) ? '-' : '+'; }
+
+		tenths = std::abs(tenths);
+		size += writeInt(&data[size], tenths / 10);
+		if (tenths < 1000) {
+			data[size++] = '.';
+			data[size++] = static_cast<char>('0' + tenths % 10);
+		}
+		if (size + 2 <= CellSize) {
+			data[size++] = 'd';
+			data[size++] = 'B';
+		}
+
+		this->writeValue(lowerLine, strip, data, size);
+	}
+
+	void LCDLayout::setPan(bool lowerLine, int strip, float pan) {
+		int percent = static_cast<int>(std::lround(std::clamp(pan, -1.f, 1.f) * 100));
+		if (percent == 0) {
+			this->writeValue(lowerLine, strip, "C", 1);
+			return;
+		}
+
+		char data[16];
+		int size = 0;
+		data[size++] = (percent < 0) ? 'L' : 'R';
+		size += writeInt(&data[size], std::abs(percent));
+
+		this->writeValue(lowerLine, strip, data, size);
+	}
+
+	void LCDLayout::setPercent(bool lowerLine, int strip, float value) {
+		char data[16];
+		int size = writeInt(data, static_cast<int>(std::lround(std::clamp(value, 0.f, 1.f) * 100)));
+		data[size++] = '%';
+
+		this->writeValue(lowerLine, strip, data, size);
+	}
+
+	void LCDLayout::clear() {
+		char blank[CellSize];
+		std::fill(std::begin(blank), std::end(blank), ' ');
+		for (int strip = 0; strip < CellNum; strip++) {
+			this->writeCell(false, strip, blank);
+			this->writeCell(true, strip, blank);
+		}
+	}
+
+	int LCDLayout::createMessages(std::vector<Message>& messages) {
+		int count = 0;
+		for (int line = 0; line < 2; line++) {
+			auto [start, end] = this->dirty[line];
+			if (start < end) {
+				messages.emplace_back(Message::createLCD(
+					Message::toLCDPlace(line == 1, static_cast<uint8_t>(start)), &this->lines[line][start], end - start));
+				count++;
+			}
+			this->dirty[line] = { LineSize, 0 };
+		}
+		return count;
+	}
+
+	void LCDLayout::invalidate() {
+		this->dirty.fill({ 0, LineSize });
+	}
+
+	const char* LCDLayout::getLine(bool lowerLine) const {
+		return this->lines[lowerLine ? 1 : 0].data();
+	}
+
+	void LCDLayout::setRules(AbbreviationRule rules) {
+		this->rules = rules;
+		std::fill(this->cache.begin(), this->cache.end(), CacheEntry{});
+	}
+
+	std::tuple<uint64_t, uint64_t> LCDLayout::getCacheStats() const {
+		return { this->cacheHits, this->cacheMisses };
+	}
+
+	void LCDLayout::abbreviate(std::string_view text, AbbreviationRule rules, char* output, int size) {
+		std::fill(output, output + size, ' ');
+		if (size <= 0) { return; }
+
+		text = trim(text);
+		if (static_cast<int>(text.size()) <= size) {
+			std::copy(text.begin(), text.end(), output);
+			return;
+		}
+
+		std::string_view suffix;
+		if (hasRule(rules, AbbreviationRule::KeepNumericSuffix)) {
+			std::size_t pos = text.size();
+			while (pos > 0 && isDigit(text[pos - 1])) { pos--; }
+			if (pos > 0 && pos < text.size() && static_cast<int>(text.size() - pos) < size) {
+				suffix = text.substr(pos);
+				text = trim(text.substr(0, pos));
+			}
+		}
+		int budget = size - static_cast<int>(suffix.size());
+
+		//Split words into a fixed buffer
+		constexpr int maxChars = 64, maxWords = 16;
+		char chars[maxChars];
+		int starts[maxWords] = {}, lengths[maxWords] = {};
+		int wordNum = 0, total = 0;
+		bool inWord = false;
+		for (char c : text) {
+			if (isSeparator(c)) {
+				inWord = false;
+				continue;
+			}
+			if (!inWord) {
+				if (wordNum == maxWords) { break; }
+				starts[wordNum] = total;
+				wordNum++;
+				inWord = true;
+			}
+			if (total == maxChars) { break; }
+			chars[total++] = c;
+			lengths[wordNum - 1]++;
+		}
+
+		if (total > budget && hasRule(rules, AbbreviationRule::DropVowels)) {
+			for (int i = 0; i < wordNum; i++) {
+				int kept = 1;
+				for (int j = 1; j < lengths[i]; j++) {
+					char c = chars[starts[i] + j];
+					if (!isLowerVowel(c)) {
+						chars[starts[i] + kept++] = c;
+					}
+				}
+				total -= lengths[i] - kept;
+				lengths[i] = kept;
+			}
+		}
+
+		if (total > budget && hasRule(rules, AbbreviationRule::WordInitials)) {
+			while (total > budget) {
+				int longest = 0;
+				for (int i = 1; i < wordNum; i++) {
+					if (lengths[i] > lengths[longest]) { longest = i; }
+				}
+				if (lengths[longest] <= 1) { break; }
+				lengths[longest]--;
+				total--;
+			}
+		}
+
+		int pos = 0;
+		for (int i = 0; i < wordNum && pos < budget; i++) {
+			int count = std::min(lengths[i], budget - pos);
+			std::memcpy(&output[pos], &chars[starts[i]], count);
+			pos += count;
+		}
+		std::copy(suffix.begin(), suffix.end(), &output[pos]);
+	}
+
+	void LCDLayout::writeCell(bool lowerLine, int strip, const char* cell) {
+		if (strip < 0 || strip >= CellNum) { return; }
+
+		int line = lowerLine ? 1 : 0;
+		int start = strip * CellSize;
+		if (std::memcmp(&this->lines[line][start], cell, CellSize) == 0) { return; }
+
+		std::memcpy(&this->lines[line][start], cell, CellSize);
+		auto& [dirtyStart, dirtyEnd] = this->dirty[line];
+		dirtyStart = std::min(dirtyStart, start);
+		dirtyEnd = std::max(dirtyEnd, start + CellSize);
+	}
+
+	void LCDLayout::writeValue(bool lowerLine, int strip, const char* data, int size) {
+		//Values are right aligned
+		char cell[CellSize];
+		size = std::min(size, CellSize);
+		std::fill(std::begin(cell), std::end(cell), ' ');
+		std::memcpy(&cell[CellSize - size], data, size);
+
+		this->writeCell(lowerLine, strip, cell);
+	}
+
+	const char* LCDLayout::lookup(std::string_view text) {
+		if (static_cast<int>(text.size()) > CacheEntry::KeySize) {
+			this->cacheMisses++;
+			LCDLayout::abbreviate(text, this->rules, this->scratch.data(), CellSize);
+			return this->scratch.data();
+		}
+
+		uint64_t hash = hashText(text);
+		auto& entry = this->cache[hash & (this->cache.size() - 1)];
+		if (entry.used && entry.hash == hash && entry.keySize == text.size()
+			&& std::memcmp(entry.key, text.data(), text.size()) == 0) {
+			this->cacheHits++;
+			return entry.value;
+		}
+
+		this->cacheMisses++;
+		entry.hash = hash;
+		entry.keySize = static_cast<uint8_t>(text.size());
+		entry.used = true;
+		std::memcpy(entry.key, text.data(), text.size());
+		LCDLayout::abbreviate(text, this->rules, entry.value, CellSize);
+		return entry.value;
+	}
+}
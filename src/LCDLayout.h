@@ -0,0 +1,156 @@
+/*****************************************************************//**
+ * \file	LCDLayout.h
+ * \brief	Per-strip text layout of the Mackie Control LCD.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#include <string_view>
+
+namespace mackieControl {
+	/**
+	 * Abbreviation rules of LCD cell text. Rules can be combined as bit mask.
+	 */
+	enum class AbbreviationRule : uint8_t {
+		None = 0,
+		/**
+		 * Drop lower case vowels except the first letter of each word.
+		 */
+		DropVowels = 1 << 0,
+		/**
+		 * Shorten the longest words first, down to their initials.
+		 */
+		WordInitials = 1 << 1,
+		/**
+		 * Keep trailing digits, such as track numbers.
+		 */
+		KeepNumericSuffix = 1 << 2,
+		All = DropVowels | WordInitials | KeepNumericSuffix
+	};
+
+	/**
+	 * Layout of the 8 x 2 strip cells on the Mackie Control LCD.
+	 * Names are abbreviated to the cell width, and the results are memoised in a fixed-size hash cache keyed by the
+	 * source text. Values are formatted into cells directly, so no string is allocated on refresh.
+	 */
+	class LCDLayout final {
+	public:
+		/**
+		 * Number of characters of one strip cell.
+		 */
+		static constexpr int CellSize = 7;
+		/**
+		 * Number of strip cells of one line.
+		 */
+		static constexpr int CellNum = 8;
+		/**
+		 * Number of characters of one line.
+		 */
+		static constexpr int LineSize = CellSize * CellNum;
+
+		/**
+		 * Create a blank layout.
+		 * \param rules			Abbreviation Rules
+		 * \param cacheSize		Cache Entries (rounded up to power of 2)
+		 */
+		explicit LCDLayout(AbbreviationRule rules = AbbreviationRule::All, int cacheSize = 256);
+
+		/**
+		 * Set the text of a cell. Text longer than the cell is abbreviated.
+		 * \param lowerLine		Upper/Lower Line
+		 * \param strip			Strip Index (0-7)
+		 * \param text			Text
+		 */
+		void setText(bool lowerLine, int strip, std::string_view text);
+		/**
+		 * Set a decibel value to a cell, such as "-12.5dB" or "-inf".
+		 * \param lowerLine		Upper/Lower Line
+		 * \param strip			Strip Index (0-7)
+		 * \param decibels		Value (dB)
+		 */
+		void setDecibels(bool lowerLine, int strip, float decibels);
+		/**
+		 * Set a pan value to a cell, such as "L50", "C" or "R100".
+		 * \param lowerLine		Upper/Lower Line
+		 * \param strip			Strip Index (0-7)
+		 * \param pan			Value (-1 to 1)
+		 */
+		void setPan(bool lowerLine, int strip, float pan);
+		/**
+		 * Set a percent value to a cell, such as "75%".
+		 * \param lowerLine		Upper/Lower Line
+		 * \param strip			Strip Index (0-7)
+		 * \param value			Value (0 to 1)
+		 */
+		void setPercent(bool lowerLine, int strip, float value);
+		/**
+		 * Fill all cells with spaces.
+		 */
+		void clear();
+
+		/**
+		 * Append LCD messages of the changed characters of each line, and mark all characters as sent.
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Appended
+		 */
+		int createMessages(std::vector<Message>& messages);
+		/**
+		 * Mark all characters as changed, so the next createMessages() sends whole lines.
+		 */
+		void invalidate();
+
+		/**
+		 * Get the characters of a line.
+		 * \return	Data Pointer (LineSize characters)
+		 */
+		const char* getLine(bool lowerLine) const;
+
+		/**
+		 * Set the abbreviation rules. This clears the cache.
+		 */
+		void setRules(AbbreviationRule rules);
+		/**
+		 * Get the number of cache hits and misses.
+		 * \return	Hits, Misses
+		 */
+		std::tuple<uint64_t, uint64_t> getCacheStats() const;
+
+		/**
+		 * Abbreviate the text to fit the size. The output is padded with spaces.
+		 * \param text			Text
+		 * \param rules			Abbreviation Rules
+		 * \param output		Output Pointer
+		 * \param size			Output Size
+		 */
+		static void abbreviate(std::string_view text, AbbreviationRule rules, char* output, int size);
+
+	private:
+		struct CacheEntry final {
+			static constexpr int KeySize = 32;
+
+			uint64_t hash = 0;
+			uint8_t keySize = 0;
+			bool used = false;
+			char key[KeySize] = {};
+			char value[CellSize] = {};
+		};
+
+		std::array<std::array<char, LineSize>, 2> lines = {};
+		std::array<std::tuple<int, int>, 2> dirty = {};
+		std::vector<CacheEntry> cache;
+		std::array<char, CellSize> scratch = {};
+		AbbreviationRule rules;
+		uint64_t cacheHits = 0, cacheMisses = 0;
+
+		void writeCell(bool lowerLine, int strip, const char* cell);
+		void writeValue(bool lowerLine, int strip, const char* data, int size);
+		const char* lookup(std::string_view text);
+	};
+}
@@ -0,0 +1,1366 @@
+/*****************************************************************//**
+ * \file	MackieControlCore.h
+ * \brief	Header-only Mackie Control protocol core over a pluggable MIDI backend.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace mackieControl {
+	/**
+	 * Mackie Control messages via MIDI system exclusive message.
+	 */
+	enum class SysExMessage : uint8_t {
+		DeviceQuery = 0,
+		HostConnectionQuery,
+		HostConnectionReply,
+		HostConnectionConfirmation,
+		HostConnectionError,
+		LCDBackLightSaver = 11,
+		TouchlessMovableFaders,
+		FaderTouchSensitivity = 14,
+		GoOffline,
+		TimeCodeBBTDisplay,
+		Assignment7SegmentDisplay,
+		LCD,
+		VersionRequest,
+		VersionReply,
+		ChannelMeterMode = 32,
+		GlobalLCDMeterMode,
+		AllFaderstoMinimum = 97,
+		AllLEDsOff,
+		Reset
+	};
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidSysExMessage(SysExMessage mes);
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidSysExMessage(int mes);
+
+	/**
+	 * Mackie Control messages via MIDI note message velocity data.
+	 */
+	enum class VelocityMessage : uint8_t {
+		Off = 0,
+		Flashing,
+		On = 127
+	};
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidVelocityMessage(VelocityMessage mes);
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidVelocityMessage(int mes);
+
+	/**
+	 * Mackie Control messages via MIDI note message note number data.
+	 */
+	enum class NoteMessage {
+		RECRDYCh1, RECRDYCh2, RECRDYCh3, RECRDYCh4, RECRDYCh5, RECRDYCh6, RECRDYCh7, RECRDYCh8,
+		SOLOCh1, SOLOCh2, SOLOCh3, SOLOCh4, SOLOCh5, SOLOCh6, SOLOCh7, SOLOCh8,
+		MUTECh1, MUTECh2, MUTECh3, MUTECh4, MUTECh5, MUTECh6, MUTECh7, MUTECh8,
+		SELECTCh1, SELECTCh2, SELECTCh3, SELECTCh4, SELECTCh5, SELECTCh6, SELECTCh7, SELECTCh8,
+		VSelectCh1, VSelectCh2, VSelectCh3, VSelectCh4, VSelectCh5, VSelectCh6, VSelectCh7, VSelectCh8,
+		ASSIGNMENTTRACK, ASSIGNMENTSEND, ASSIGNMENTPANSURROUND, ASSIGNMENTPLUGIN, ASSIGNMENTEQ, ASSIGNMENTINSTRUMENT,
+		FADERBANKSBANKLeft, FADERBANKSBANKRight, FADERBANKSCHANNELLeft, FADERBANKSCHANNELRight,
+		FLIP,
+		GLOBALVIEW,
+		NAMEVALUE,
+		SMPTEBEATS,
+		Function1, Function2, Function3, Function4, Function5, Function6, Function7, Function8,
+		GLOBALVIEWMIDITRACKS, GLOBALVIEWINPUTS, GLOBALVIEWAUDIOTRACKS, GLOBALVIEWAUDIOINSTRUMENT,
+		GLOBALVIEWAUX, GLOBALVIEWBUSSES, GLOBALVIEWOUTPUTS, GLOBALVIEWUSER,
+		SHIFT, OPTION, CONTROL, CMDALT,
+		AUTOMATIONREADOFF, AUTOMATIONWRITE, AUTOMATIONTRIM, AUTOMATIONTOUCH, AUTOMATIONLATCH,
+		GROUP,
+		UTILITIESSAVE, UTILITIESUNDO, UTILITIESCANCEL, UTILITIESENTER,
+		MARKER,
+		NUDGE,
+		CYCLE,
+		DROP,
+		REPLACE,
+		CLICK,
+		SOLO,
+		REWIND, FASTFWD, STOP, PLAY, RECORD,
+		CursorUp, CursorDown, CursorLeft, CursorRight,
+		Zoom,
+		Scrub,
+		UserSwitchA, UserSwitchB,
+		FaderTouchCh1, FaderTouchCh2, FaderTouchCh3, FaderTouchCh4,
+		FaderTouchCh5, FaderTouchCh6, FaderTouchCh7, FaderTouchCh8,
+		FaderTouchMaster,
+		SMPTELED,
+		BEATSLED,
+		RUDESOLOLIGHT,
+		Relayclick
+	};
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidNoteMessage(NoteMessage mes);
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidNoteMessage(int mes);
+
+	/**
+	 * Mackie Control messages via MIDI controller message controller number data.
+	 */
+	enum class CCMessage {
+		VPot1 = 16, VPot2, VPot3, VPot4, VPot5, VPot6, VPot7, VPot8,
+		ExternalController = 46,
+		VPotLEDRing1 = 48, VPotLEDRing2, VPotLEDRing3, VPotLEDRing4,
+		VPotLEDRing5, VPotLEDRing6, VPotLEDRing7, VPotLEDRing8,
+		JogWheel = 60,
+		TimeCodeBBTDisplay1 = 64, TimeCodeBBTDisplay2, TimeCodeBBTDisplay3, TimeCodeBBTDisplay4,
+		TimeCodeBBTDisplay5, TimeCodeBBTDisplay6, TimeCodeBBTDisplay7, TimeCodeBBTDisplay8,
+		TimeCodeBBTDisplay9, TimeCodeBBTDisplay10,
+		Assignment7SegmentDisplay1, Assignment7SegmentDisplay2, Assignment7SegmentDisplay3
+	};
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidCCMessage(CCMessage mes);
+	/**
+	 * Check if the message is valid.
+	 */
+	constexpr bool isValidCCMessage(int mes);
+
+	/**
+	 * Rotation direction of wheel messages.
+	 */
+	enum class WheelType {
+		CW, CCW
+	};
+
+	/**
+	 * LED ring mode of V-Pot on Mackie Control devices.
+	 */
+	enum class VPotLEDRingMode {
+		SingleDotMode,
+		BoostCutMode,
+		WrapMode,
+		SpreadMode
+	};
+
+	/**
+	 * Short MIDI message of up to 3 bytes, stored by value.
+	 */
+	struct ShortMidiMessage final {
+		std::array<uint8_t, 3> data = {};
+		uint8_t size = 0;
+	};
+
+	/**
+	 * View of raw MIDI bytes owned by someone else.
+	 */
+	struct MidiByteSpan final {
+		const uint8_t* data = nullptr;
+		int size = 0;
+	};
+
+	/**
+	 * MIDI backend of short messages stored in a 3-byte POD. System exclusive messages can not be stored, and are
+	 * created as empty messages.
+	 */
+	class ShortMessageBackend final {
+	public:
+		using NativeType = ShortMidiMessage;
+
+		ShortMessageBackend() = default;
+		explicit ShortMessageBackend(const NativeType& message)
+			: message(message) {}
+
+		static ShortMessageBackend fromRawData(const uint8_t* data, int size) {
+			ShortMidiMessage message;
+			if (size > 0 && size <= static_cast<int>(message.data.size())) {
+				std::memcpy(message.data.data(), data, size);
+				message.size = static_cast<uint8_t>(size);
+			}
+			return ShortMessageBackend{ message };
+		}
+
+		const NativeType& getNative() const { return this->message; }
+		const uint8_t* getRawData() const { return this->message.data.data(); }
+		int getRawDataSize() const { return this->message.size; }
+
+	private:
+		ShortMidiMessage message;
+	};
+
+	/**
+	 * MIDI backend of raw byte spans, such as a receive buffer. The bytes are not copied, so this backend can only
+	 * decode messages, and the bytes must outlive the message.
+	 */
+	class ByteSpanBackend final {
+	public:
+		using NativeType = MidiByteSpan;
+
+		ByteSpanBackend() = default;
+		explicit ByteSpanBackend(const NativeType& message)
+			: message(message) {}
+
+		const NativeType& getNative() const { return this->message; }
+		const uint8_t* getRawData() const { return this->message.data; }
+		int getRawDataSize() const { return this->message.data ? this->message.size : 0; }
+
+	private:
+		MidiByteSpan message;
+	};
+
+	/**
+	 * Mackie Control Message class.
+	 * The protocol logic works on the raw MIDI bytes of the backend, so it is independent of JUCE and can be inlined
+	 * at call sites. A backend provides:
+	 * \code
+	 * using NativeType = ...;										//MIDI message type of the backend
+	 * Backend();													//Empty message
+	 * explicit Backend(const NativeType& message);
+	 * static Backend fromRawData(const uint8_t* data, int size);	//Only needed to create messages
+	 * const NativeType& getNative() const;
+	 * const uint8_t* getRawData() const;
+	 * int getRawDataSize() const;
+	 * \endcode
+	 */
+	template <class Backend>
+	class BasicMessage final {
+	public:
+		/**
+		 * MIDI message type of the backend.
+		 */
+		using NativeType = typename Backend::NativeType;
+
+		/**
+		 * Create an empty Mackie Control message. An empty message is an invalid Mackie Control message.
+		 */
+		BasicMessage() = default;
+		/**
+		 * Create a Mackie Control message from a MIDI message.
+		 */
+		explicit BasicMessage(const NativeType& midiMessage);
+
+		/**
+		 * Create a copy of another message.
+		 */
+		explicit BasicMessage(const BasicMessage& message);
+		/**
+		 * Move constructor.
+		 */
+		explicit BasicMessage(BasicMessage&& message) noexcept;
+
+		/**
+		 * Copy this message from another one.
+		 */
+		BasicMessage& operator=(const BasicMessage& message);
+		/**
+		 * Move assignment operator.
+		 */
+		BasicMessage& operator=(BasicMessage&& message) noexcept;
+
+		/**
+		 * Copy this message from a MIDI message.
+		 */
+		BasicMessage& operator=(const NativeType& message);
+		/**
+		 * Convert this message to MIDI message.
+		 */
+		NativeType toMidi() const;
+		/**
+		 * Get the raw MIDI data of this message.
+		 */
+		const uint8_t* getRawData() const;
+		/**
+		 * Get the raw MIDI data size of this message.
+		 */
+		int getRawDataSize() const;
+
+		/**
+		 * Check if this message is a valid Mackie Control message via MIDI system exclusive message.
+		 */
+		bool isSysEx() const;
+		/**
+		 * Check if this message is a valid Mackie Control message via MIDI note message.
+		 */
+		bool isNote() const;
+		/**
+		 * Check if this message is a valid Mackie Control message via MIDI controller message.
+		 */
+		bool isCC() const;
+		/**
+		 * Check if this message is a valid Mackie Control message via MIDI pitch wheel message.
+		 */
+		bool isPitchWheel() const;
+		/**
+		 * Check if this message is a valid Mackie Control message via MIDI channel pressure message.
+		 */
+		bool isChannelPressure() const;
+
+		/**
+		 * Check if this message is a valid Mackie Control message.
+		 */
+		bool isMackieControl() const;
+
+		/**
+		 * Get the type of Mackie Control message via MIDI system exclusive message.
+		 * \return	Message Type
+		 */
+		std::tuple<SysExMessage> getSysExData() const;
+		/**
+		 * Get the Host Connection Query message data.
+		 * \return	Serial Number, Challenge Code
+		 */
+		std::tuple<std::array<uint8_t, 7>, uint32_t> getHostConnectionQueryData() const;
+		/**
+		 * Get the Host Connection Reply message data.
+		 * \return	Serial Number, Response Code
+		 */
+		std::tuple<std::array<uint8_t, 7>, uint32_t> getHostConnectionReplyData() const;
+		/**
+		 * Get the Host Connection Confirmation message data.
+		 * \return	Serial Number
+		 */
+		std::tuple<std::array<uint8_t, 7>> getHostConnectionConfirmationData() const;
+		/**
+		 * Get the Host Connection Error message data.
+		 * \return	Serial Number
+		 */
+		std::tuple<std::array<uint8_t, 7>> getHostConnectionErrorData() const;
+		/**
+		 * Get the LCD Back Light Saver message data.
+		 * \return	Back Light On/Off, Timeout
+		 */
+		std::tuple<uint8_t, uint8_t> getLCDBackLightSaverData() const;
+		/**
+		 * Get the Touchless Movable Faders message data.
+		 * \return	Touch On/Off
+		 */
+		std::tuple<uint8_t> getTouchlessMovableFadersData() const;
+		/**
+		 * Get the Fader Touch Sensitivity message data.
+		 * \return	 Channel Number, Value
+		 */
+		std::tuple<uint8_t, uint8_t> getFaderTouchSensitivityData() const;
+		/**
+		 * Get the Time Code/BBT Display message data.
+		 * \return	Data Pointer, Data Size
+		 */
+		std::tuple<const uint8_t*, int> getTimeCodeBBTDisplayData() const;
+		/**
+		 * Get the Assignment 7-Segment Display message data.
+		 * \return	Data
+		 */
+		std::tuple<std::array<uint8_t, 2>> getAssignment7SegmentDisplayData() const;
+		/**
+		 * Get the LCD message data.
+		 * \return	Line Place, Data Pointer, Data Size
+		 */
+		std::tuple<uint8_t, const char*, int> getLCDData() const;
+		/**
+		 * Get the Version Reply message data.
+		 * \return	Value Pointer, Value Size
+		 */
+		std::tuple<const char*, int> getVersionReplyData() const;
+		/**
+		 * Get the Channel Meter Mode message data.
+		 * \return	Channel Number, Mode
+		 */
+		std::tuple<uint8_t, uint8_t> getChannelMeterModeData() const;
+		/**
+		 * Get the Global LCD Meter Mode message data.
+		 * \return	Horizontal/Vertical Mode
+		 */
+		std::tuple<uint8_t> getGlobalLCDMeterModeData() const;
+		/**
+		 * Get the type of Mackie Control message via MIDI note message.
+		 * \return	Message Type, Message On/Off Type
+		 */
+		std::tuple<NoteMessage, VelocityMessage> getNoteData() const;
+		/**
+		 * Get the type of Mackie Control message via MIDI controller message.
+		 * \return	Message Type, Value
+		 */
+		std::tuple<CCMessage, int> getCCData() const;
+		/**
+		 * Get the type of Mackie Control message via MIDI pitch wheel message.
+		 * \return	Channel Number, Fader Value
+		 */
+		std::tuple<int, int> getPitchWheelData() const;
+		/**
+		 * Get the type of Mackie Control message via MIDI channel pressure message.
+		 * \return	Meter Channel Number, Meter Value
+		 */
+		std::tuple<int, int> getChannelPressureData() const;
+
+	public:
+		/**
+		 * Convert MIDI message to Mackie Control message.
+		 */
+		static BasicMessage fromMidi(const NativeType& message);
+		/**
+		 * Convert Mackie Control message to MIDI message.
+		 */
+		static NativeType toMidi(const BasicMessage& message);
+
+		/**
+		 * Create a Device Query message.
+		 */
+		static BasicMessage createDeviceQuery();
+		/**
+		 * Create a Host Connection Query message.
+		 * \param serialNum		Serial Number
+		 * \param challengeCode	Challenge Code
+		 */
+		static BasicMessage createHostConnectionQuery(const std::array<uint8_t, 7>& serialNum, uint32_t challengeCode);
+		/**
+		 * Create a Host Connection Reply message.
+		 * \param serialNum		Serial Number
+		 * \param responseCode	Response Code
+		 */
+		static BasicMessage createHostConnectionReply(const std::array<uint8_t, 7>& serialNum, uint32_t responseCode);
+		/**
+		 * Create a Host Connection Confirmation message.
+		 * \param serialNum		Serial Number
+		 */
+		static BasicMessage createHostConnectionConfirmation(const std::array<uint8_t, 7>& serialNum);
+		/**
+		 * Create a Host Connection Error message.
+		 * \param serialNum		Serial Number
+		 */
+		static BasicMessage createHostConnectionError(const std::array<uint8_t, 7>& serialNum);
+		/**
+		 * Create an LCD Back Light Saver message.
+		 * \param state			Back Light On/Off
+		 * \param timeout		Timeout (min)
+		 */
+		static BasicMessage createLCDBackLightSaver(uint8_t state, uint8_t timeout);
+		/**
+		 * Create a Touchless Movable Faders message.
+		 * \param state			Touch On/Off
+		 */
+		static BasicMessage createTouchlessMovableFaders(uint8_t state);
+		/**
+		 * Create a Fader Touch Sensitivity message.
+		 * \param channelNumber	Channel Number
+		 * \param value			Value
+		 */
+		static BasicMessage createFaderTouchSensitivity(uint8_t channelNumber, uint8_t value);
+		/**
+		 * Create a Go Offline message.
+		 */
+		static BasicMessage createGoOffline();
+		/**
+		 * Create a Time Code/BBT Display message. This will create the own copy of the data.
+		 * \param data			Data Pointer (Mackie Control Character)
+		 * \param size			Data Size
+		 */
+		static BasicMessage createTimeCodeBBTDisplay(const uint8_t* data, int size);
+		/**
+		 * Create an Assignment 7-Segment Display message.
+		 * \param data			Data (Mackie Control Character)
+		 */
+		static BasicMessage createAssignment7SegmentDisplay(const std::array<uint8_t, 2>& data);
+		/**
+		 * Create an LCD message. This will create the own copy of the data.
+		 * \param place			Line Place
+		 * \param data			Data Pointer
+		 * \param size			Data Size
+		 */
+		static BasicMessage createLCD(uint8_t place, const char* data, int size);
+		/**
+		 * Create a Version Request message.
+		 */
+		static BasicMessage createVersionRequest();
+		/**
+		 * Create a Version Reply message. This will create the own copy of the data.
+		 * \param data			Data Pointer
+		 * \param size			Data Size
+		 */
+		static BasicMessage createVersionReply(const char* data, int size);
+		/**
+		 * Create a Channel Meter Mode message.
+		 * \param channelNumber	Channel Number
+		 * \param mode			Mode
+		 */
+		static BasicMessage createChannelMeterMode(uint8_t channelNumber, uint8_t mode);
+		/**
+		 * Create a Global LCD Meter Mode message.
+		 * \param mode			Horizontal/Vertical Mode
+		 */
+		static BasicMessage createGlobalLCDMeterMode(uint8_t mode);
+		/**
+		 * Create an All Faders to Minimum message.
+		 */
+		static BasicMessage createAllFaderstoMinimum();
+		/**
+		 * Create an All LEDs Off message.
+		 */
+		static BasicMessage createAllLEDsOff();
+		/**
+		 * Create a Reset message.
+		 */
+		static BasicMessage createReset();
+		/**
+		 * Create a Mackie Control message via MIDI note message.
+		 * \param type			Message Type
+		 * \param vel			Message On/Off Type
+		 */
+		static BasicMessage createNote(NoteMessage type, VelocityMessage vel);
+		/**
+		 * Create a Mackie Control message via MIDI controller message.
+		 * \param type			Message Type
+		 * \param value			Value
+		 */
+		static BasicMessage createCC(CCMessage type, int value);
+		/**
+		 * Create a Mackie Control message via MIDI pitch wheel message.
+		 * \param channel		Channel Number
+		 * \param value			Fader Value
+		 */
+		static BasicMessage createPitchWheel(int channel, int value);
+		/**
+		 * Create a Mackie Control message via MIDI channel pressure message.
+		 * \param channel		Meter Channel Number
+		 * \param value			Meter Value
+		 */
+		static BasicMessage createChannelPressure(int channel, int value);
+
+		/**
+		 * Convert ASCII character to Mackie Control character.
+		 */
+		static uint8_t charToMackie(char c);
+		/**
+		 * Convert Mackie Control character to ASCII character.
+		 */
+		static char mackieToChar(uint8_t c);
+
+		/**
+		 * Create place param of LCD message.
+		 * \param lowerLine		Upper/Lower Line
+		 * \param index			Character Index
+		 */
+		static uint8_t toLCDPlace(bool lowerLine, uint8_t index);
+		/**
+		 * Create mode param of Channel Meter Mode message.
+		 * \param signalLEDEnabled			Signal LED Enabled
+		 * \param peakHoldDisplayEnabled	Peak Hold Display Enabled
+		 * \param LCDLevelMeterEnabled		LCD Level Meter Enabled
+		 */
+		static uint8_t toChannelMeterMode(
+			bool signalLEDEnabled, bool peakHoldDisplayEnabled, bool LCDLevelMeterEnabled);
+		/**
+		 * Create value param of V-Pot message.
+		 * \param type			Wheel Rotation Direction
+		 * \param ticks			Wheel Rotation Ticks
+		 */
+		static int toVPotValue(WheelType type, int ticks);
+		/**
+		 * Create value param of V-Pot LED Ring message.
+		 * \param centerLEDOn	Center LED On/Off
+		 * \param mode			LED Ring Mode
+		 * \param value			Value
+		 */
+		static int toVPotLEDRingValue(bool centerLEDOn, VPotLEDRingMode mode, int value);
+		/**
+		 * Create value param of Jog Wheel message.
+		 * \param type			Wheel Rotation Direction
+		 * \param ticks			Wheel Rotation Ticks
+		 */
+		static int toJogWheelValue(WheelType type, int ticks);
+
+		/**
+		 * Get place data of LCD message.
+		 * \return	Upper/Lower Line, Character Index
+		 */
+		static std::tuple<bool, uint8_t> convertLCDPlace(uint8_t place);
+		/**
+		 * Get mode data of Channel Meter Mode message.
+		 * \return	Signal LED Enabled, Peak Hold Display Enabled, LCD Level Meter Enabled
+		 */
+		static std::tuple<bool, bool, bool> convertChannelMeterMode(uint8_t mode);
+		/**
+		 * Get value data of V-Pot message.
+		 * \return	Wheel Rotation Direction, Wheel Rotation Ticks
+		 */
+		static std::tuple<WheelType, int> convertVPotValue(int value);
+		/**
+		 * Get value data of V-Pot LED Ring message.
+		 * \return	Center LED On/Off, LED Ring Mode, Value
+		 */
+		static std::tuple<bool, VPotLEDRingMode, int> convertVPotLEDRingValue(int value);
+		/**
+		 * Get value data of Jog Wheel message.
+		 * \return	Wheel Rotation Direction, Wheel Rotation Ticks
+		 */
+		static std::tuple<WheelType, int> convertJogWheelValue(int value);
+
+	private:
+		struct RawDataTag final {};
+
+		Backend message;
+
+		BasicMessage(RawDataTag, const uint8_t* data, int size);
+
+		uint8_t getByte(int index) const;
+		const uint8_t* getSysExPtr() const;
+		int getSysExSize() const;
+
+		static BasicMessage createShort(uint8_t status, uint8_t data1, uint8_t data2, int size);
+		static BasicMessage createSysEx(const uint8_t* data, int size);
+		static uint8_t toStatus(uint8_t type, int channel);
+	};
+
+	inline constexpr auto validSysExMessage = std::to_array({
+		SysExMessage::DeviceQuery,
+		SysExMessage::HostConnectionQuery,
+		SysExMessage::HostConnectionReply,
+		SysExMessage::HostConnectionConfirmation,
+		SysExMessage::HostConnectionError,
+		SysExMessage::LCDBackLightSaver,
+		SysExMessage::TouchlessMovableFaders,
+		SysExMessage::FaderTouchSensitivity,
+		SysExMessage::GoOffline,
+		SysExMessage::TimeCodeBBTDisplay,
+		SysExMessage::Assignment7SegmentDisplay,
+		SysExMessage::LCD,
+		SysExMessage::VersionRequest,
+		SysExMessage::VersionReply,
+		SysExMessage::ChannelMeterMode,
+		SysExMessage::GlobalLCDMeterMode,
+		SysExMessage::AllFaderstoMinimum,
+		SysExMessage::AllLEDsOff,
+		SysExMessage::Reset
+		});
+	constexpr bool isValidSysExMessage(SysExMessage mes) {
+		return std::find(validSysExMessage.begin(), validSysExMessage.end(), mes) != validSysExMessage.end();
+	}
+	constexpr bool isValidSysExMessage(int mes) {
+		return isValidSysExMessage(static_cast<SysExMessage>(mes));
+	}
+
+	inline constexpr auto validVelocityMessage = std::to_array({
+		VelocityMessage::Off,
+		VelocityMessage::Flashing,
+		VelocityMessage::On
+		});
+	constexpr bool isValidVelocityMessage(VelocityMessage mes) {
+		return std::find(validVelocityMessage.begin(), validVelocityMessage.end(), mes) != validVelocityMessage.end();
+	}
+	constexpr bool isValidVelocityMessage(int mes) {
+		return isValidVelocityMessage(static_cast<VelocityMessage>(mes));
+	}
+
+	inline constexpr auto validNoteMessage = std::to_array({
+		NoteMessage::RECRDYCh1, NoteMessage::RECRDYCh2, NoteMessage::RECRDYCh3, NoteMessage::RECRDYCh4,
+		NoteMessage::RECRDYCh5, NoteMessage::RECRDYCh6, NoteMessage::RECRDYCh7, NoteMessage::RECRDYCh8,
+		NoteMessage::SOLOCh1, NoteMessage::SOLOCh2, NoteMessage::SOLOCh3, NoteMessage::SOLOCh4,
+		NoteMessage::SOLOCh5, NoteMessage::SOLOCh6, NoteMessage::SOLOCh7, NoteMessage::SOLOCh8,
+		NoteMessage::MUTECh1, NoteMessage::MUTECh2, NoteMessage::MUTECh3, NoteMessage::MUTECh4,
+		NoteMessage::MUTECh5, NoteMessage::MUTECh6, NoteMessage::MUTECh7, NoteMessage::MUTECh8,
+		NoteMessage::SELECTCh1, NoteMessage::SELECTCh2, NoteMessage::SELECTCh3, NoteMessage::SELECTCh4,
+		NoteMessage::SELECTCh5, NoteMessage::SELECTCh6, NoteMessage::SELECTCh7, NoteMessage::SELECTCh8,
+		NoteMessage::VSelectCh1, NoteMessage::VSelectCh2, NoteMessage::VSelectCh3, NoteMessage::VSelectCh4,
+		NoteMessage::VSelectCh5, NoteMessage::VSelectCh6, NoteMessage::VSelectCh7, NoteMessage::VSelectCh8,
+		NoteMessage::ASSIGNMENTTRACK, NoteMessage::ASSIGNMENTSEND, NoteMessage::ASSIGNMENTPANSURROUND,
+		NoteMessage::ASSIGNMENTPLUGIN, NoteMessage::ASSIGNMENTEQ, NoteMessage::ASSIGNMENTINSTRUMENT,
+		NoteMessage::FADERBANKSBANKLeft, NoteMessage::FADERBANKSBANKRight,
+		NoteMessage::FADERBANKSCHANNELLeft, NoteMessage::FADERBANKSCHANNELRight,
+		NoteMessage::FLIP,
+		NoteMessage::GLOBALVIEW,
+		NoteMessage::NAMEVALUE,
+		NoteMessage::SMPTEBEATS,
+		NoteMessage::Function1, NoteMessage::Function2, NoteMessage::Function3, NoteMessage::Function4,
+		NoteMessage::Function5, NoteMessage::Function6, NoteMessage::Function7, NoteMessage::Function8,
+		NoteMessage::GLOBALVIEWMIDITRACKS, NoteMessage::GLOBALVIEWINPUTS,
+		NoteMessage::GLOBALVIEWAUDIOTRACKS, NoteMessage::GLOBALVIEWAUDIOINSTRUMENT,
+		NoteMessage::GLOBALVIEWAUX, NoteMessage::GLOBALVIEWBUSSES,
+		NoteMessage::GLOBALVIEWOUTPUTS, NoteMessage::GLOBALVIEWUSER,
+		NoteMessage::SHIFT, NoteMessage::OPTION, NoteMessage::CONTROL, NoteMessage::CMDALT,
+		NoteMessage::AUTOMATIONREADOFF, NoteMessage::AUTOMATIONWRITE, NoteMessage::AUTOMATIONTRIM,
+		NoteMessage::AUTOMATIONTOUCH, NoteMessage::AUTOMATIONLATCH,
+		NoteMessage::GROUP,
+		NoteMessage::UTILITIESSAVE, NoteMessage::UTILITIESUNDO,
+		NoteMessage::UTILITIESCANCEL, NoteMessage::UTILITIESENTER,
+		NoteMessage::MARKER,
+		NoteMessage::NUDGE,
+		NoteMessage::CYCLE,
+		NoteMessage::DROP,
+		NoteMessage::REPLACE,
+		NoteMessage::CLICK,
+		NoteMessage::SOLO,
+		NoteMessage::REWIND, NoteMessage::FASTFWD, NoteMessage::STOP, NoteMessage::PLAY, NoteMessage::RECORD,
+		NoteMessage::CursorUp, NoteMessage::CursorDown, NoteMessage::CursorLeft, NoteMessage::CursorRight,
+		NoteMessage::Zoom,
+		NoteMessage::Scrub,
+		NoteMessage::UserSwitchA, NoteMessage::UserSwitchB,
+		NoteMessage::FaderTouchCh1, NoteMessage::FaderTouchCh2,
+		NoteMessage::FaderTouchCh3, NoteMessage::FaderTouchCh4,
+		NoteMessage::FaderTouchCh5, NoteMessage::FaderTouchCh6,
+		NoteMessage::FaderTouchCh7, NoteMessage::FaderTouchCh8,
+		NoteMessage::FaderTouchMaster,
+		NoteMessage::SMPTELED,
+		NoteMessage::BEATSLED,
+		NoteMessage::RUDESOLOLIGHT,
+		NoteMessage::Relayclick
+		});
+	constexpr bool isValidNoteMessage(NoteMessage mes) {
+		return std::find(validNoteMessage.begin(), validNoteMessage.end(), mes) != validNoteMessage.end();
+	}
+	constexpr bool isValidNoteMessage(int mes) {
+		return isValidNoteMessage(static_cast<NoteMessage>(mes));
+	}
+
+	inline constexpr auto validCCMessage = std::to_array({
+		CCMessage::VPot1, CCMessage::VPot2, CCMessage::VPot3, CCMessage::VPot4,
+		CCMessage::VPot5, CCMessage::VPot6, CCMessage::VPot7, CCMessage::VPot8,
+		CCMessage::ExternalController,
+		CCMessage::VPotLEDRing1, CCMessage::VPotLEDRing2, CCMessage::VPotLEDRing3, CCMessage::VPotLEDRing4,
+		CCMessage::VPotLEDRing5, CCMessage::VPotLEDRing6, CCMessage::VPotLEDRing7, CCMessage::VPotLEDRing8,
+		CCMessage::JogWheel,
+		CCMessage::TimeCodeBBTDisplay1, CCMessage::TimeCodeBBTDisplay2,
+		CCMessage::TimeCodeBBTDisplay3, CCMessage::TimeCodeBBTDisplay4,
+		CCMessage::TimeCodeBBTDisplay5, CCMessage::TimeCodeBBTDisplay6,
+		CCMessage::TimeCodeBBTDisplay7, CCMessage::TimeCodeBBTDisplay8,
+		CCMessage::TimeCodeBBTDisplay9, CCMessage::TimeCodeBBTDisplay10,
+		CCMessage::Assignment7SegmentDisplay1, CCMessage::Assignment7SegmentDisplay2,
+		CCMessage::Assignment7SegmentDisplay3
+		});
+	constexpr bool isValidCCMessage(CCMessage mes) {
+		return std::find(validCCMessage.begin(), validCCMessage.end(), mes) != validCCMessage.end();
+	}
+	constexpr bool isValidCCMessage(int mes) {
+		return isValidCCMessage(static_cast<CCMessage>(mes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend>::BasicMessage(const NativeType& midiMessage)
+		: message(midiMessage) {}
+
+	template <class Backend>
+	BasicMessage<Backend>::BasicMessage(const BasicMessage& message)
+		: message(message.message) {}
+
+	template <class Backend>
+	BasicMessage<Backend>::BasicMessage(BasicMessage&& message) noexcept
+		: message(std::move(message.message)) {}
+
+	template <class Backend>
+	BasicMessage<Backend>& BasicMessage<Backend>::operator=(const BasicMessage& message) {
+		if (this != &message) {
+			this->message = message.message;
+		}
+		return *this;
+	}
+
+	template <class Backend>
+	BasicMessage<Backend>& BasicMessage<Backend>::operator=(BasicMessage&& message) noexcept {
+		if (this != &message) {
+			this->message = std::move(message.message);
+		}
+		return *this;
+	}
+
+	template <class Backend>
+	BasicMessage<Backend>& BasicMessage<Backend>::operator=(const NativeType& message) {
+		this->message = Backend{ message };
+		return *this;
+	}
+
+	template <class Backend>
+	typename BasicMessage<Backend>::NativeType BasicMessage<Backend>::toMidi() const {
+		return this->message.getNative();
+	}
+
+	template <class Backend>
+	const uint8_t* BasicMessage<Backend>::getRawData() const {
+		return this->message.getRawData();
+	}
+
+	template <class Backend>
+	int BasicMessage<Backend>::getRawDataSize() const {
+		return this->message.getRawDataSize();
+	}
+
+	template <class Backend>
+	bool BasicMessage<Backend>::isSysEx() const {
+		if (this->getByte(0) == 0xF0) {
+			if (this->getSysExSize() >= 5) {
+				auto ptrData = this->getSysExPtr();
+				return isValidSysExMessage(ptrData[4]);
+			}
+		}
+		return false;
+	}
+
+	template <class Backend>
+	bool BasicMessage<Backend>::isNote() const {
+		if ((this->getByte(0) & 0xE0) == 0x80) {
+			return isValidNoteMessage(this->getByte(1)) &&
+				isValidVelocityMessage(this->getByte(2));
+		}
+		return false;
+	}
+
+	template <class Backend>
+	bool BasicMessage<Backend>::isCC() const {
+		if ((this->getByte(0) & 0xF0) == 0xB0) {
+			return isValidCCMessage(this->getByte(1));
+		}
+		return false;
+	}
+
+	template <class Backend>
+	bool BasicMessage<Backend>::isPitchWheel() const {
+		if ((this->getByte(0) & 0xF0) == 0xE0) {
+			auto channel = (this->getByte(0) & 0x0F) + 1;
+			return channel >= 1 && channel <= 9;
+		}
+		return false;
+	}
+
+	template <class Backend>
+	bool BasicMessage<Backend>::isChannelPressure() const {
+		if ((this->getByte(0) & 0xF0) == 0xD0) {
+			return true;
+		}
+		return false;
+	}
+
+	template <class Backend>
+	bool BasicMessage<Backend>::isMackieControl() const {
+		return this->isSysEx() ||
+			this->isNote() ||
+			this->isCC() ||
+			this->isPitchWheel() ||
+			this->isChannelPressure();
+	}
+
+	template <class Backend>
+	std::tuple<SysExMessage> BasicMessage<Backend>::getSysExData() const {
+		if (this->getSysExSize() < 5) { return { static_cast<SysExMessage>(-1) }; }
+		return { static_cast<SysExMessage>(this->getSysExPtr()[4]) };
+	}
+
+	template <class Backend>
+	std::tuple<std::array<uint8_t, 7>, uint32_t> BasicMessage<Backend>::getHostConnectionQueryData() const {
+		if (this->getSysExSize() <
+			5 + sizeof(std::array<uint8_t, 7>) + sizeof(uint32_t)) { return std::tuple<std::array<uint8_t, 7>, uint32_t>{}; }
+
+		std::array<uint8_t, 7> bytes;
+		std::memcpy(bytes.data(), &(this->getSysExPtr()[5]), sizeof(bytes));
+
+		return { bytes, static_cast<uint32_t>(this->getSysExPtr()[5 + sizeof(bytes)]) };
+	}
+
+	template <class Backend>
+	std::tuple<std::array<uint8_t, 7>, uint32_t> BasicMessage<Backend>::getHostConnectionReplyData() const {
+		if (this->getSysExSize() <
+			5 + sizeof(std::array<uint8_t, 7>) + sizeof(uint32_t)) {
+			return std::tuple<std::array<uint8_t, 7>, uint32_t>{};
+		}
+
+		std::array<uint8_t, 7> bytes;
+		std::memcpy(bytes.data(), &(this->getSysExPtr()[5]), sizeof(bytes));
+
+		return { bytes, static_cast<uint32_t>(this->getSysExPtr()[5 + sizeof(bytes)]) };
+	}
+
+	template <class Backend>
+	std::tuple<std::array<uint8_t, 7>> BasicMessage<Backend>::getHostConnectionConfirmationData() const {
+		if (this->getSysExSize() < 5 + sizeof(std::array<uint8_t, 7>)) {
+			return std::tuple<std::array<uint8_t, 7>>{};
+		}
+
+		std::array<uint8_t, 7> bytes;
+		std::memcpy(bytes.data(), &(this->getSysExPtr()[5]), sizeof(bytes));
+
+		return { bytes };
+	}
+
+	template <class Backend>
+	std::tuple<std::array<uint8_t, 7>> BasicMessage<Backend>::getHostConnectionErrorData() const {
+		if (this->getSysExSize() < 5 + sizeof(std::array<uint8_t, 7>)) {
+			return std::tuple<std::array<uint8_t, 7>>{};
+		}
+
+		std::array<uint8_t, 7> bytes;
+		std::memcpy(bytes.data(), &(this->getSysExPtr()[5]), sizeof(bytes));
+
+		return { bytes };
+	}
+
+	template <class Backend>
+	std::tuple<uint8_t, uint8_t> BasicMessage<Backend>::getLCDBackLightSaverData() const {
+		if (this->getSysExSize() < 5 + 1) {
+			return std::tuple<uint8_t, uint8_t>{};
+		}
+
+		return { static_cast<uint8_t>(this->getSysExPtr()[5]),
+			(this->getSysExSize() >= 7) ? static_cast<uint8_t>(this->getSysExPtr()[6]) : 0 };
+	}
+
+	template <class Backend>
+	std::tuple<uint8_t> BasicMessage<Backend>::getTouchlessMovableFadersData() const {
+		if (this->getSysExSize() < 5 + 1) {
+			return std::tuple<uint8_t>{};
+		}
+
+		return { static_cast<uint8_t>(this->getSysExPtr()[5]) };
+	}
+
+	template <class Backend>
+	std::tuple<uint8_t, uint8_t> BasicMessage<Backend>::getFaderTouchSensitivityData() const {
+		if (this->getSysExSize() < 5 + 2) {
+			return std::tuple<uint8_t, uint8_t>{};
+		}
+
+		return { static_cast<uint8_t>(this->getSysExPtr()[5]),
+			static_cast<uint8_t>(this->getSysExPtr()[6]) };
+	}
+
+	template <class Backend>
+	std::tuple<const uint8_t*, int> BasicMessage<Backend>::getTimeCodeBBTDisplayData() const {
+		if (this->getSysExSize() < 5 + 1 + 1 + 1) {
+			return std::tuple<uint8_t*, int>{};
+		}
+
+		return { &(this->getSysExPtr()[6]),
+			this->getSysExSize() - 1 - 6 };
+	}
+
+	template <class Backend>
+	std::tuple<std::array<uint8_t, 2>> BasicMessage<Backend>::getAssignment7SegmentDisplayData() const {
+		if (this->getSysExSize() < 5 + 1 + static_cast<int>(sizeof(std::array<uint8_t, 2>))) {
+			return std::tuple<std::array<uint8_t, 2>>{};
+		}
+
+		std::array<uint8_t, 2> bytes;
+		std::memcpy(bytes.data(), &(this->getSysExPtr()[6]), sizeof(bytes));
+
+		return { bytes };
+	}
+
+	template <class Backend>
+	std::tuple<uint8_t, const char*, int> BasicMessage<Backend>::getLCDData() const {
+		if (this->getSysExSize() < 5 + 1 + 1) {
+			return std::tuple<uint8_t, char*, int>{};
+		}
+
+		return { static_cast<uint8_t>(this->getSysExPtr()[5]),
+			reinterpret_cast<const char*>(&(this->getSysExPtr()[6])) ,
+			this->getSysExSize() - 6 };
+	}
+
+	template <class Backend>
+	std::tuple<const char*, int> BasicMessage<Backend>::getVersionReplyData() const {
+		if (this->getSysExSize() < 5 + 1 + 1) {
+			return std::tuple<char*, int>{};
+		}
+
+		return { reinterpret_cast<const char*>(&(this->getSysExPtr()[6])) ,
+			this->getSysExSize() - 6 };
+	}
+
+	template <class Backend>
+	std::tuple<uint8_t, uint8_t> BasicMessage<Backend>::getChannelMeterModeData() const {
+		if (this->getSysExSize() < 5 + 2) {
+			return std::tuple<uint8_t, uint8_t>{};
+		}
+
+		return { static_cast<uint8_t>(this->getSysExPtr()[5]),
+			static_cast<uint8_t>(this->getSysExPtr()[6]) };
+	}
+
+	template <class Backend>
+	std::tuple<uint8_t> BasicMessage<Backend>::getGlobalLCDMeterModeData() const {
+		if (this->getSysExSize() < 5 + 1) {
+			return std::tuple<uint8_t>{};
+		}
+
+		return { static_cast<uint8_t>(this->getSysExPtr()[5]) };
+	}
+
+	template <class Backend>
+	std::tuple<NoteMessage, VelocityMessage> BasicMessage<Backend>::getNoteData() const {
+		return { static_cast<NoteMessage>(this->getByte(1)),
+			static_cast<VelocityMessage>(((this->getByte(0) & 0xE0) == 0x80) ? this->getByte(2) : 0) };
+	}
+
+	template <class Backend>
+	std::tuple<CCMessage, int> BasicMessage<Backend>::getCCData() const {
+		return { static_cast<CCMessage>(this->getByte(1)),
+			this->getByte(2) };
+	}
+
+	template <class Backend>
+	std::tuple<int, int> BasicMessage<Backend>::getPitchWheelData() const {
+		return { ((this->getByte(0) & 0xF0) != 0xF0) ? ((this->getByte(0) & 0x0F) + 1) : 0,
+			this->getByte(1) | (this->getByte(2) << 7) };
+	}
+
+	template <class Backend>
+	std::tuple<int, int> BasicMessage<Backend>::getChannelPressureData() const {
+		int value = this->getByte(1);
+		return { value / 16 + 1,value % 16 };
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::fromMidi(const NativeType& message) {
+		return BasicMessage{ message };
+	}
+
+	template <class Backend>
+	typename BasicMessage<Backend>::NativeType BasicMessage<Backend>::toMidi(const BasicMessage& message) {
+		return message.toMidi();
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createDeviceQuery() {
+		uint8_t bytes[5] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::DeviceQuery);
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createHostConnectionQuery(const std::array<uint8_t, 7>& serialNum, uint32_t challengeCode) {
+		uint8_t bytes[5 + sizeof(serialNum) + sizeof(challengeCode)] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::HostConnectionQuery);
+		std::memcpy(&bytes[5], serialNum.data(), sizeof(serialNum));
+		std::memcpy(&bytes[5 + sizeof(serialNum)], &challengeCode, sizeof(challengeCode));
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createHostConnectionReply(const std::array<uint8_t, 7>& serialNum, uint32_t responseCode) {
+		uint8_t bytes[5 + sizeof(serialNum) + sizeof(responseCode)] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::HostConnectionReply);
+		std::memcpy(&bytes[5], serialNum.data(), sizeof(serialNum));
+		std::memcpy(&bytes[5 + sizeof(serialNum)], &responseCode, sizeof(responseCode));
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createHostConnectionConfirmation(const std::array<uint8_t, 7>& serialNum) {
+		uint8_t bytes[5 + sizeof(serialNum)] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::HostConnectionConfirmation);
+		std::memcpy(&bytes[5], serialNum.data(), sizeof(serialNum));
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createHostConnectionError(const std::array<uint8_t, 7>& serialNum) {
+		uint8_t bytes[5 + sizeof(serialNum)] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::HostConnectionError);
+		std::memcpy(&bytes[5], serialNum.data(), sizeof(serialNum));
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createLCDBackLightSaver(uint8_t state, uint8_t timeout) {
+		if (state > 0) {
+			uint8_t bytes[5 + 2] = {};
+			bytes[4] = static_cast<uint8_t>(SysExMessage::LCDBackLightSaver);
+			bytes[5] = state;
+			bytes[6] = timeout;
+
+			return BasicMessage::createSysEx(bytes, sizeof(bytes));
+		}
+		
+		uint8_t bytes[5 + 1] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::LCDBackLightSaver);
+		bytes[5] = state;
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createTouchlessMovableFaders(uint8_t state) {
+		uint8_t bytes[5 + 1] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::TouchlessMovableFaders);
+		bytes[5] = state;
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createFaderTouchSensitivity(uint8_t channelNumber, uint8_t value) {
+		uint8_t bytes[5 + 2] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::FaderTouchSensitivity);
+		bytes[5] = channelNumber;
+		bytes[6] = value;
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createGoOffline() {
+		uint8_t bytes[5] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::GoOffline);
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createTimeCodeBBTDisplay(const uint8_t* data, int size) {
+		int byteSize = 5 + 1 + size + 1;
+		auto bytes = std::unique_ptr<uint8_t[]>(new uint8_t[byteSize]());
+
+		bytes[4] = static_cast<uint8_t>(SysExMessage::TimeCodeBBTDisplay);
+		std::memcpy(&bytes[6], data, size);
+
+		return BasicMessage::createSysEx(bytes.get(), byteSize);
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createAssignment7SegmentDisplay(const std::array<uint8_t, 2>& data) {
+		uint8_t bytes[5 + 1 + sizeof(data)] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::Assignment7SegmentDisplay);
+		std::memcpy(&bytes[6], data.data(), sizeof(data));
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createLCD(uint8_t place, const char* data, int size) {
+		int byteSize = 5 + 1 + size;
+		auto bytes = std::unique_ptr<uint8_t[]>(new uint8_t[byteSize]());
+
+		bytes[4] = static_cast<uint8_t>(SysExMessage::LCD);
+		bytes[5] = place;
+		std::memcpy(&bytes[6], data, size);
+
+		return BasicMessage::createSysEx(bytes.get(), byteSize);
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createVersionRequest() {
+		uint8_t bytes[5] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::VersionRequest);
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createVersionReply(const char* data, int size) {
+		int byteSize = 5 + 1 + size;
+		auto bytes = std::unique_ptr<uint8_t[]>(new uint8_t[byteSize]());
+
+		bytes[4] = static_cast<uint8_t>(SysExMessage::VersionReply);
+		std::memcpy(&bytes[6], data, size);
+
+		return BasicMessage::createSysEx(bytes.get(), byteSize);
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createChannelMeterMode(uint8_t channelNumber, uint8_t mode) {
+		uint8_t bytes[5 + 2] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::ChannelMeterMode);
+		bytes[5] = channelNumber;
+		bytes[6] = mode;
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createGlobalLCDMeterMode(uint8_t mode) {
+		uint8_t bytes[5 + 1] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::GlobalLCDMeterMode);
+		bytes[5] = mode;
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createAllFaderstoMinimum() {
+		uint8_t bytes[5] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::AllFaderstoMinimum);
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createAllLEDsOff() {
+		uint8_t bytes[5] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::AllLEDsOff);
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createReset() {
+		uint8_t bytes[5] = {};
+		bytes[4] = static_cast<uint8_t>(SysExMessage::Reset);
+
+		return BasicMessage::createSysEx(bytes, sizeof(bytes));
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createNote(NoteMessage type, VelocityMessage vel) {
+		return BasicMessage::createShort(BasicMessage::toStatus(0x90, 1),
+			static_cast<int>(type) & 127, std::min(static_cast<uint8_t>(vel), uint8_t{ 127 }), 3);
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createCC(CCMessage type, int value) {
+		return BasicMessage::createShort(BasicMessage::toStatus(0xB0, 1),
+			static_cast<int>(type) & 127, value & 127, 3);
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createPitchWheel(int channel, int value) {
+		return BasicMessage::createShort(BasicMessage::toStatus(0xE0, channel),
+			value & 127, (value >> 7) & 127, 3);
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createChannelPressure(int channel, int value) {
+		return BasicMessage::createShort(BasicMessage::toStatus(0xD0, 1),
+			((channel - 1) * 16 + value) & 127, 0, 2);
+	}
+
+	template <class Backend>
+	uint8_t BasicMessage<Backend>::charToMackie(char c) {
+		if (c >= 'a' && c <= 'z') { return (c - 'a') + 1; }
+		else if (c >= 'A' && c <= 'Z') { return (c - 'A') + 1; }
+		else if (c >= '0' && c <= '9') { return c; }
+
+		return ' ';
+	}
+
+	template <class Backend>
+	char BasicMessage<Backend>::mackieToChar(uint8_t c) {
+		if ((c - 1) >= 0 && (c - 1) <= 'Z' - 'A') { return 'A' + (c - 1); }
+		else if (c >= '0' && c <= '9') { return c; }
+
+		return ' ';
+	}
+
+	template <class Backend>
+	uint8_t BasicMessage<Backend>::toLCDPlace(bool lowerLine, uint8_t index) {
+		return (lowerLine ? 56 : 0) + index;
+	}
+
+	template <class Backend>
+	uint8_t BasicMessage<Backend>::toChannelMeterMode(
+		bool signalLEDEnabled, bool peakHoldDisplayEnabled, bool LCDLevelMeterEnabled) {
+		return (static_cast<uint8_t>(signalLEDEnabled) << 0)
+			+ (static_cast<uint8_t>(peakHoldDisplayEnabled) << 1)
+			+ (static_cast<uint8_t>(LCDLevelMeterEnabled) << 2);
+	}
+
+	template <class Backend>
+	int BasicMessage<Backend>::toVPotValue(WheelType type, int ticks) {
+		return static_cast<int>(type) * 64 + ticks;
+	}
+
+	template <class Backend>
+	int BasicMessage<Backend>::toVPotLEDRingValue(bool centerLEDOn, VPotLEDRingMode mode, int value) {
+		return static_cast<int>(centerLEDOn) * 64
+			+ static_cast<int>(mode) * 16
+			+ value;
+	}
+
+	template <class Backend>
+	int BasicMessage<Backend>::toJogWheelValue(WheelType type, int ticks) {
+		return static_cast<int>(type) * 64 + ticks;
+	}
+
+	template <class Backend>
+	std::tuple<bool, uint8_t> BasicMessage<Backend>::convertLCDPlace(uint8_t place) {
+		return { place >= 56, (place >= 56) ? (place - 56) : place };
+	}
+
+	template <class Backend>
+	std::tuple<bool, bool, bool> BasicMessage<Backend>::convertChannelMeterMode(uint8_t mode) {
+		return { mode & (1 << 0),
+			mode & (1 << 1),
+			mode & (1 << 2) };
+	}
+
+	template <class Backend>
+	std::tuple<WheelType, int> BasicMessage<Backend>::convertVPotValue(int value) {
+		return { static_cast<WheelType>(value / 64), value % 64 };
+	}
+
+	template <class Backend>
+	std::tuple<bool, VPotLEDRingMode, int> BasicMessage<Backend>::convertVPotLEDRingValue(int value) {
+		return { static_cast<bool>(value / 64), static_cast<VPotLEDRingMode>((value % 64) / 16), value % 16 };
+	}
+
+	template <class Backend>
+	std::tuple<WheelType, int> BasicMessage<Backend>::convertJogWheelValue(int value) {
+		return { static_cast<WheelType>(value / 64), value % 64 };
+	}
+
+	template <class Backend>
+	BasicMessage<Backend>::BasicMessage(RawDataTag, const uint8_t* data, int size)
+		: message(Backend::fromRawData(data, size)) {}
+
+	template <class Backend>
+	uint8_t BasicMessage<Backend>::getByte(int index) const {
+		//Bytes past the end read as 0, like the zeroed storage of short JUCE MIDI messages
+		return (index < this->message.getRawDataSize()) ? this->message.getRawData()[index] : 0;
+	}
+
+	template <class Backend>
+	const uint8_t* BasicMessage<Backend>::getSysExPtr() const {
+		return (this->getByte(0) == 0xF0) ? (this->message.getRawData() + 1) : nullptr;
+	}
+
+	template <class Backend>
+	int BasicMessage<Backend>::getSysExSize() const {
+		return (this->getByte(0) == 0xF0) ? (this->message.getRawDataSize() - 2) : 0;
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createShort(uint8_t status, uint8_t data1, uint8_t data2, int size) {
+		uint8_t bytes[3] = { status, data1, data2 };
+		return BasicMessage{ RawDataTag{}, bytes, size };
+	}
+
+	template <class Backend>
+	BasicMessage<Backend> BasicMessage<Backend>::createSysEx(const uint8_t* data, int size) {
+		//Most Mackie Control messages fit in the stack buffer
+		constexpr int bufferSize = 128;
+		if (size + 2 <= bufferSize) {
+			uint8_t bytes[bufferSize];
+			bytes[0] = 0xF0;
+			std::memcpy(&bytes[1], data, size);
+			bytes[size + 1] = 0xF7;
+			return BasicMessage{ RawDataTag{}, bytes, size + 2 };
+		}
+
+		std::vector<uint8_t> bytes(size + 2);
+		bytes.front() = 0xF0;
+		std::memcpy(&bytes[1], data, size);
+		bytes.back() = 0xF7;
+		return BasicMessage{ RawDataTag{}, bytes.data(), size + 2 };
+	}
+
+	template <class Backend>
+	uint8_t BasicMessage<Backend>::toStatus(uint8_t type, int channel) {
+		return type | static_cast<uint8_t>(std::clamp(channel - 1, 0, 15));
+	}
+}
@@ -0,0 +1,358 @@
+/*****************************************************************//**
+ * \file	MappingTable.cpp
+ * \brief	User mapping files compiled into flat dispatch tables.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MappingTable.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <thread>
+
+namespace mackieControl {
+	static constexpr const char* noteNames[] = {
+		"RECRDYCh1", "RECRDYCh2", "RECRDYCh3", "RECRDYCh4", "RECRDYCh5", "RECRDYCh6", "RECRDYCh7", "RECRDYCh8",
+		"SOLOCh1", "SOLOCh2", "SOLOCh3", "SOLOCh4", "SOLOCh5", "SOLOCh6", "SOLOCh7", "SOLOCh8", "MUTECh1", "MUTECh2",
+		"MUTECh3", "MUTECh4", "MUTECh5", "MUTECh6", "MUTECh7", "MUTECh8", "SELECTCh1", "SELECTCh2", "SELECTCh3",
+		"SELECTCh4", "SELECTCh5", "SELECTCh6", "SELECTCh7", "SELECTCh8", "VSelectCh1", "VSelectCh2", "VSelectCh3",
+		"VSelectCh4", "VSelectCh5", "VSelectCh6", "VSelectCh7", "VSelectCh8", "ASSIGNMENTTRACK", "ASSIGNMENTSEND",
+		"ASSIGNMENTPANSURROUND", "ASSIGNMENTPLUGIN", "ASSIGNMENTEQ", "ASSIGNMENTINSTRUMENT", "FADERBANKSBANKLeft",
+		"FADERBANKSBANKRight", "FADERBANKSCHANNELLeft", "FADERBANKSCHANNELRight", "FLIP", "GLOBALVIEW", "NAMEVALUE",
+		"SMPTEBEATS", "Function1", "Function2", "Function3", "Function4", "Function5", "Function6", "Function7",
+		"Function8", "GLOBALVIEWMIDITRACKS", "GLOBALVIEWINPUTS", "GLOBALVIEWAUDIOTRACKS",
+		"GLOBALVIEWAUDIOINSTRUMENT", "GLOBALVIEWAUX", "GLOBALVIEWBUSSES", "GLOBALVIEWOUTPUTS", "GLOBALVIEWUSER",
+		"SHIFT", "OPTION", "CONTROL", "CMDALT", "AUTOMATIONREADOFF", "AUTOMATIONWRITE", "AUTOMATIONTRIM",
+		"AUTOMATIONTOUCH", "AUTOMATIONLATCH", "GROUP", "UTILITIESSAVE", "UTILITIESUNDO", "UTILITIESCANCEL",
+		"UTILITIESENTER", "MARKER", "NUDGE", "CYCLE", "DROP", "REPLACE", "CLICK", "SOLO", "REWIND", "FASTFWD",
+		"STOP", "PLAY", "RECORD", "CursorUp", "CursorDown", "CursorLeft", "CursorRight", "Zoom", "Scrub",
+		"UserSwitchA", "UserSwitchB", "FaderTouchCh1", "FaderTouchCh2", "FaderTouchCh3", "FaderTouchCh4",
+		"FaderTouchCh5", "FaderTouchCh6", "FaderTouchCh7", "FaderTouchCh8", "FaderTouchMaster", "SMPTELED",
+		"BEATSLED", "RUDESOLOLIGHT", "Relayclick"
+	};
+	static_assert(std::size(noteNames) == static_cast<std::size_t>(NoteMessage::Relayclick) + 1);
+
+	struct CCName final {
+		int controller;
+		const char* name;
+	};
+
+	static constexpr CCName CCNames[] = {
+		{ 16, "VPot1" }, { 17, "VPot2" }, { 18, "VPot3" }, { 19, "VPot4" }, { 20, "VPot5" }, { 21, "VPot6" },
+		{ 22, "VPot7" }, { 23, "VPot8" }, { 46, "ExternalController" }, { 48, "VPotLEDRing1" },
+		{ 49, "VPotLEDRing2" }, { 50, "VPotLEDRing3" }, { 51, "VPotLEDRing4" }, { 52, "VPotLEDRing5" },
+		{ 53, "VPotLEDRing6" }, { 54, "VPotLEDRing7" }, { 55, "VPotLEDRing8" }, { 60, "JogWheel" },
+		{ 64, "TimeCodeBBTDisplay1" }, { 65, "TimeCodeBBTDisplay2" }, { 66, "TimeCodeBBTDisplay3" },
+		{ 67, "TimeCodeBBTDisplay4" }, { 68, "TimeCodeBBTDisplay5" }, { 69, "TimeCodeBBTDisplay6" },
+		{ 70, "TimeCodeBBTDisplay7" }, { 71, "TimeCodeBBTDisplay8" }, { 72, "TimeCodeBBTDisplay9" },
+		{ 73, "TimeCodeBBTDisplay10" }, { 74, "Assignment7SegmentDisplay1" }, { 75, "Assignment7SegmentDisplay2" },
+		{ 76, "Assignment7SegmentDisplay3" }
+	};
+
+	struct MappingRule final {
+		int kind;
+		int id;
+		int channel;
+		int modifiers;
+		int16_t action;
+	};
+
+	static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+		if (a.size() != b.size()) { return false; }
+		for (std::size_t i = 0; i < a.size(); i++) {
+			if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static std::string_view trim(std::string_view text) {
+		auto start = text.find_first_not_of(" \t\r");
+		if (start == std::string_view::npos) { return {}; }
+		auto end = text.find_last_not_of(" \t\r");
+		return text.substr(start, end - start + 1);
+	}
+
+	static bool parseInt(std::string_view text, int min, int max, int& result) {
+		int value = 0;
+		auto [ptr, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (error != std::errc{} || ptr != text.data() + text.size() || value < min || value > max) { return false; }
+		result = value;
+		return true;
+	}
+
+	static int parseModifiers(std::string_view text) {
+		if (text == "*") { return -1; }
+
+		int modifiers = 0;
+		while (!text.empty()) {
+			auto end = text.find('+');
+			auto name = text.substr(0, end);
+			text = (end == std::string_view::npos) ? std::string_view{} : text.substr(end + 1);
+
+			if (equalsIgnoreCase(name, "none")) { continue; }
+			else if (equalsIgnoreCase(name, "shift")) { modifiers |= static_cast<int>(ModifierFlags::Shift); }
+			else if (equalsIgnoreCase(name, "option")) { modifiers |= static_cast<int>(ModifierFlags::Option); }
+			else if (equalsIgnoreCase(name, "control")) { modifiers |= static_cast<int>(ModifierFlags::Control); }
+			else if (equalsIgnoreCase(name, "cmdalt")) { modifiers |= static_cast<int>(ModifierFlags::CmdAlt); }
+			else { return -2; }
+		}
+		return modifiers;
+	}
+
+	static bool parseRule(std::string_view line, const std::vector<std::string>& actions, MappingRule& rule) {
+		auto equal = line.find('=');
+		if (equal == std::string_view::npos) { return false; }
+
+		//Action
+		auto action = trim(line.substr(equal + 1));
+		auto it = std::find(actions.begin(), actions.end(), action);
+		int actionID = 0;
+		if (it != actions.end()) { actionID = static_cast<int>(it - actions.begin()); }
+		else if (!parseInt(action, 0, INT16_MAX, actionID)) { return false; }
+		rule.action = static_cast<int16_t>(actionID);
+
+		//Kind, id, channel and modifiers
+		std::array<std::string_view, 3> tokens;
+		int tokenNum = 0;
+		auto input = line.substr(0, equal);
+		while (true) {
+			auto start = input.find_first_not_of(" \t");
+			if (start == std::string_view::npos) { break; }
+			auto end = input.find_first_of(" \t", start);
+			if (tokenNum >= static_cast<int>(tokens.size())) { return false; }
+			tokens[tokenNum++] = input.substr(start, end - start);
+			input = (end == std::string_view::npos) ? std::string_view{} : input.substr(end);
+		}
+		if (tokenNum < 2) { return false; }
+
+		auto slash = tokens[1].find('/');
+		auto id = tokens[1].substr(0, slash);
+		rule.channel = 0;
+		if (slash != std::string_view::npos) {
+			if (!parseInt(tokens[1].substr(slash + 1), 1, 16, rule.channel)) { return false; }
+			rule.channel--;
+		}
+
+		if (equalsIgnoreCase(tokens[0], "note")) {
+			rule.kind = static_cast<int>(MappingKind::Note);
+			rule.id = MappingTable::findNote(id);
+			if (rule.id < 0 && !parseInt(id, 0, 127, rule.id)) { return false; }
+		}
+		else if (equalsIgnoreCase(tokens[0], "cc")) {
+			rule.kind = static_cast<int>(MappingKind::CC);
+			rule.id = MappingTable::findCC(id);
+			if (rule.id < 0 && !parseInt(id, 0, 127, rule.id)) { return false; }
+		}
+		else if (equalsIgnoreCase(tokens[0], "fader")) {
+			rule.kind = static_cast<int>(MappingKind::Fader);
+			if (slash != std::string_view::npos || !parseInt(id, 1, 9, rule.id)) { return false; }
+			rule.id--;
+		}
+		else {
+			return false;
+		}
+
+		rule.modifiers = (tokenNum > 2) ? parseModifiers(tokens[2]) : 0;
+		return rule.modifiers >= -1;
+	}
+
+	std::unique_ptr<MappingTable> MappingTable::compile(std::string_view text,
+		const std::vector<std::string>& actions, int* errorLine) {
+		if (errorLine) { *errorLine = 0; }
+
+		std::vector<MappingRule> rules;
+		int lineNum = 0;
+		while (!text.empty()) {
+			auto end = text.find('\n');
+			auto line = text.substr(0, end);
+			text = (end == std::string_view::npos) ? std::string_view{} : text.substr(end + 1);
+			lineNum++;
+
+			line = trim(line.substr(0, line.find('#')));
+			if (line.empty()) { continue; }
+
+			MappingRule rule{};
+			if (!parseRule(line, actions, rule)) {
+				if (errorLine) { *errorLine = lineNum; }
+				return nullptr;
+			}
+			rules.push_back(rule);
+		}
+
+		//Each kind only takes the ids and channels its rules use
+		auto table = std::unique_ptr<MappingTable>(new MappingTable);
+		for (auto& rule : rules) {
+			table->idNums[rule.kind] = std::max(table->idNums[rule.kind], rule.id + 1);
+			table->channelNums[rule.kind] = std::max(table->channelNums[rule.kind], rule.channel + 1);
+		}
+		int size = 0;
+		for (int i = 0; i < KindNum; i++) {
+			table->offsets[i] = size;
+			size += table->idNums[i] * table->channelNums[i] * ModifierNum;
+		}
+		table->entries.assign(size, static_cast<int16_t>(NoAction));
+		table->ruleNum = static_cast<int>(rules.size());
+
+		//Rules for any modifier go first, so rules with exact modifiers override them
+		std::stable_partition(rules.begin(), rules.end(), [](const MappingRule& rule) { return rule.modifiers < 0; });
+		for (auto& rule : rules) {
+			int base = table->offsets[rule.kind]
+				+ (rule.id * table->channelNums[rule.kind] + rule.channel) * ModifierNum;
+			if (rule.modifiers < 0) {
+				std::fill_n(&table->entries[base], ModifierNum, rule.action);
+			}
+			else {
+				table->entries[base + rule.modifiers] = rule.action;
+			}
+		}
+
+		return table;
+	}
+
+	std::unique_ptr<MappingTable> MappingTable::compileFile(const std::string& path,
+		const std::vector<std::string>& actions, int* errorLine) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			if (errorLine) { *errorLine = 0; }
+			return nullptr;
+		}
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+		return MappingTable::compile(stream.str(), actions, errorLine);
+	}
+
+	int MappingTable::lookup(MappingKind kind, int id, int channel, ModifierFlags modifiers) const {
+		int k = static_cast<int>(kind);
+		int c = channel - 1;
+		if (k >= KindNum || id < 0 || id >= this->idNums[k] || c < 0 || c >= this->channelNums[k]) {
+			return NoAction;
+		}
+		return this->entries[this->offsets[k]
+			+ (id * this->channelNums[k] + c) * ModifierNum + (static_cast<int>(modifiers) & (ModifierNum - 1))];
+	}
+
+	int MappingTable::lookup(const Message& message, ModifierFlags modifiers) const {
+		auto data = message.getRawData();
+		if (message.getRawDataSize() < 3) { return NoAction; }
+
+		int channel = (data[0] & 0x0F) + 1;
+		switch (data[0] & 0xF0) {
+		case 0x80:
+			return NoAction;
+		case 0x90:
+			//Buttons are released with velocity 0, only the press triggers the action
+			if ((data[2] & 127) == 0) { return NoAction; }
+			return this->lookup(MappingKind::Note, data[1] & 127, channel, modifiers);
+		case 0xB0:
+			return this->lookup(MappingKind::CC, data[1] & 127, channel, modifiers);
+		case 0xE0:
+			return this->lookup(MappingKind::Fader, channel - 1, 1, modifiers);
+		default:
+			return NoAction;
+		}
+	}
+
+	int MappingTable::getRuleNum() const {
+		return this->ruleNum;
+	}
+
+	std::size_t MappingTable::getByteSize() const {
+		return sizeof(MappingTable) + this->entries.size() * sizeof(int16_t);
+	}
+
+	const char* MappingTable::getName(NoteMessage type) {
+		int index = static_cast<int>(type);
+		if (index < 0 || index >= static_cast<int>(std::size(noteNames))) { return nullptr; }
+		return noteNames[index];
+	}
+
+	const char* MappingTable::getName(CCMessage type) {
+		for (auto& item : CCNames) {
+			if (item.controller == static_cast<int>(type)) { return item.name; }
+		}
+		return nullptr;
+	}
+
+	int MappingTable::findNote(std::string_view name) {
+		for (int i = 0; i < static_cast<int>(std::size(noteNames)); i++) {
+			if (equalsIgnoreCase(name, noteNames[i])) { return i; }
+		}
+		return -1;
+	}
+
+	int MappingTable::findCC(std::string_view name) {
+		for (auto& item : CCNames) {
+			if (equalsIgnoreCase(name, item.name)) { return item.controller; }
+		}
+		return -1;
+	}
+
+	MappingDispatcher::MappingDispatcher()
+		: current(MappingTable::compile({})), table(this->current.get()) {}
+
+	MappingDispatcher::~MappingDispatcher() = default;
+
+	void MappingDispatcher::set(std::unique_ptr<MappingTable> table) {
+		if (!table) { return; }
+
+		this->table.store(table.get(), std::memory_order_seq_cst);
+		this->synchronize();
+		this->current = std::move(table);
+	}
+
+	bool MappingDispatcher::load(std::string_view text, const std::vector<std::string>& actions, int* errorLine) {
+		auto table = MappingTable::compile(text, actions, errorLine);
+		if (!table) { return false; }
+
+		this->set(std::move(table));
+		return true;
+	}
+
+	int MappingDispatcher::lookup(MappingKind kind, int id, int channel, ModifierFlags modifiers) const {
+		return this->read([&](const MappingTable* table) { return table->lookup(kind, id, channel, modifiers); });
+	}
+
+	int MappingDispatcher::lookup(const Message& message, ModifierFlags modifiers) const {
+		return this->read([&](const MappingTable* table) { return table->lookup(message, modifiers); });
+	}
+
+	template <typename Func>
+	int MappingDispatcher::read(Func&& func) const {
+		//The count is raised before the pointer is loaded, so a grace period which missed it sees the new pointer
+		auto& counts = this->slots[MappingDispatcher::getReaderSlot()].counts;
+		uint32_t parity = this->epoch.load(std::memory_order_seq_cst) & 1;
+		counts[parity].fetch_add(1, std::memory_order_seq_cst);
+		int result = func(this->table.load(std::memory_order_seq_cst));
+		counts[parity].fetch_sub(1, std::memory_order_release);
+		return result;
+	}
+
+	void MappingDispatcher::synchronize() {
+		//Each parity is drained once, which covers every lookup still reading the old table. The flip before each
+		//wait sends new lookups to the other parity, so the wait is not starved by them.
+		for (int phase = 0; phase < 2; phase++) {
+			uint32_t parity = this->epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+			for (auto& slot : this->slots) {
+				while (slot.counts[parity].load(std::memory_order_acquire) != 0) {
+					std::this_thread::yield();
+				}
+			}
+		}
+	}
+
+	int MappingDispatcher::getReaderSlot() {
+		static std::atomic<int> nextSlot = 0;
+		thread_local int slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % ReaderSlotNum;
+		return slot;
+	}
+}
@@ -0,0 +1,201 @@
+/*****************************************************************//**
+ * \file	MappingTable.h
+ * \brief	User mapping files compiled into flat dispatch tables.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "ChordEngine.h"
+#include <atomic>
+#include <string>
+#include <string_view>
+
+namespace mackieControl {
+	/**
+	 * Kinds of mapped input.
+	 */
+	enum class MappingKind : uint8_t {
+		/**
+		 * Button, id is NoteMessage.
+		 */
+		Note,
+		/**
+		 * Controller, id is CCMessage.
+		 */
+		CC,
+		/**
+		 * Fader, id is fader number - 1 (pitch wheel channel - 1).
+		 */
+		Fader
+	};
+
+	/**
+	 * User mapping compiled into a dense table indexed by kind, id, MIDI channel and modifier mask.
+	 * A mapping file has one rule per line, and '#' starts a comment:
+	 *
+	 *		<kind> <id>[/<channel>] [<modifiers>] = <action>
+	 *
+	 * - kind: note, cc or fader.
+	 * - id: NoteMessage or CCMessage name (case insensitive) or number, or fader number (1-9).
+	 * - channel: MIDI channel number (1-16), 1 if omitted. Faders are always on their own channel.
+	 * - modifiers: shift, option, control and cmdalt joined by '+', none for no modifier, or * for any modifier mask.
+	 *   none if omitted. Rules with * are overridden by rules with exact modifiers.
+	 * - action: an action name given to compile(), or an action ID (0-32767).
+	 *
+	 * Looking up an input is one bounds check and one indexed load. The table is immutable once compiled.
+	 */
+	class MappingTable final {
+	public:
+		/**
+		 * No action mapped.
+		 */
+		static constexpr int NoAction = -1;
+
+		/**
+		 * Compile a mapping.
+		 * \param text			Mapping Text
+		 * \param actions		Action Names, the index of a name is its action ID
+		 * \param errorLine		Output Line Number (1 based) of the first error, or 0 if there is none
+		 * \return	The table, or nullptr on error.
+		 */
+		static std::unique_ptr<MappingTable> compile(std::string_view text,
+			const std::vector<std::string>& actions = {}, int* errorLine = nullptr);
+		/**
+		 * Compile a mapping file.
+		 * \param path			File Path
+		 * \param actions		Action Names, the index of a name is its action ID
+		 * \param errorLine		Output Line Number (1 based) of the first error, 0 if there is none or the file can't be read
+		 * \return	The table, or nullptr on error.
+		 */
+		static std::unique_ptr<MappingTable> compileFile(const std::string& path,
+			const std::vector<std::string>& actions = {}, int* errorLine = nullptr);
+
+		/**
+		 * Get the action of an input.
+		 * \param kind			Input Kind
+		 * \param id			Input ID
+		 * \param channel		MIDI Channel Number (1-16)
+		 * \param modifiers		Modifier Mask
+		 * \return	Action ID, or NoAction.
+		 */
+		int lookup(MappingKind kind, int id, int channel, ModifierFlags modifiers) const;
+		/**
+		 * Get the action of a message received from the surface. Button releases (note off, or note on with velocity 0)
+		 * have no action.
+		 * \param message		Note, Controller or Pitch Wheel Message
+		 * \param modifiers		Modifier Mask
+		 * \return	Action ID, or NoAction.
+		 */
+		int lookup(const Message& message, ModifierFlags modifiers) const;
+
+		/**
+		 * Get the number of rules compiled into the table.
+		 */
+		int getRuleNum() const;
+		/**
+		 * Get the size of the table in bytes.
+		 */
+		std::size_t getByteSize() const;
+
+		/**
+		 * Get the name of a NoteMessage.
+		 * \return	The name, or nullptr if the message is not valid.
+		 */
+		static const char* getName(NoteMessage type);
+		/**
+		 * Get the name of a CCMessage.
+		 * \return	The name, or nullptr if the message is not valid.
+		 */
+		static const char* getName(CCMessage type);
+		/**
+		 * Find a NoteMessage by name, case insensitive.
+		 * \return	Note number, or -1 if not found.
+		 */
+		static int findNote(std::string_view name);
+		/**
+		 * Find a CCMessage by name, case insensitive.
+		 * \return	Controller number, or -1 if not found.
+		 */
+		static int findCC(std::string_view name);
+
+	private:
+		static constexpr int KindNum = 3;
+		static constexpr int ModifierNum = 16;
+
+		std::array<int, KindNum> idNums = {};
+		std::array<int, KindNum> channelNums = {};
+		std::array<int, KindNum> offsets = {};
+		std::vector<int16_t> entries;
+		int ruleNum = 0;
+
+		MappingTable() = default;
+	};
+
+	/**
+	 * Holder of the current MappingTable, which can be replaced at runtime while other threads look up inputs.
+	 * Lookups never lock or wait, and touch no memory written by other threads: each thread counts its lookups in its
+	 * own reader slot under the current epoch parity. Replacing the table flips the epoch twice and waits for the
+	 * lookups of the old parity to finish (a grace period), then frees the old table, so no replaced table is kept.
+	 * Tables may be replaced from one thread at a time; lookups may come from any thread.
+	 */
+	class MappingDispatcher final {
+	public:
+		/**
+		 * Number of reader slots. Threads beyond this share slots, which stays correct but shares cache lines.
+		 */
+		static constexpr int ReaderSlotNum = 64;
+
+		/**
+		 * Create a dispatcher with an empty mapping.
+		 */
+		MappingDispatcher();
+		~MappingDispatcher();
+
+		/**
+		 * Replace the mapping. Waits for the lookups in progress on the old table, never for new ones, then frees it.
+		 * \param table			Compiled Table, nullptr is ignored
+		 */
+		void set(std::unique_ptr<MappingTable> table);
+		/**
+		 * Compile and replace the mapping. The current mapping is kept on error.
+		 * \param text			Mapping Text
+		 * \param actions		Action Names, the index of a name is its action ID
+		 * \param errorLine		Output Line Number (1 based) of the first error, or 0 if there is none
+		 * \return	Whether the mapping was replaced.
+		 */
+		bool load(std::string_view text, const std::vector<std::string>& actions = {}, int* errorLine = nullptr);
+
+		/**
+		 * Get the action of an input. See MappingTable::lookup.
+		 */
+		int lookup(MappingKind kind, int id, int channel, ModifierFlags modifiers) const;
+		/**
+		 * Get the action of a message received from the surface. See MappingTable::lookup.
+		 */
+		int lookup(const Message& message, ModifierFlags modifiers) const;
+
+	private:
+		struct alignas(64) ReaderSlot final {
+			std::atomic<uint32_t> counts[2] = {};
+		};
+
+		std::unique_ptr<MappingTable> current;
+		std::atomic<const MappingTable*> table;
+		std::atomic<uint32_t> epoch = 0;
+		mutable std::array<ReaderSlot, ReaderSlotNum> slots;
+
+		template <typename Func>
+		int read(Func&& func) const;
+		void synchronize();
+		static int getReaderSlot();
+
+		MappingDispatcher(const MappingDispatcher&) = delete;
+		MappingDispatcher& operator=(const MappingDispatcher&) = delete;
+	};
+}
@@ -0,0 +1,150 @@
+/*****************************************************************//**
+ * \file	MessageFilter.cpp
+ * \brief	Early-reject prefilter of Mackie Control messages in mixed MIDI streams.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageFilter.h"
+
+namespace mackieControl {
+	template <int Size>
+	struct BitMask final {
+		std::array<uint64_t, Size / 64> bits{};
+
+		constexpr void set(int index) {
+			this->bits[index / 64] |= uint64_t{ 1 } << (index % 64);
+		}
+		constexpr bool test(uint8_t index) const {
+			return (this->bits[index / 64] >> (index % 64)) & 1;
+		}
+	};
+
+	template <typename T, std::size_t Size>
+	constexpr BitMask<128> toBitMask(const std::array<T, Size>& validTable) {
+		BitMask<128> mask;
+		for (auto mes : validTable) {
+			mask.set(static_cast<int>(mes));
+		}
+		return mask;
+	}
+
+	//The channels accepted by Message::isNote/isCC/isChannelPressure/isPitchWheel
+	constinit auto validStatusMask = [] {
+		BitMask<256> mask;
+		for (int channel = 0; channel < 16; channel++) {
+			mask.set(0x80 + channel);
+			mask.set(0x90 + channel);
+			mask.set(0xB0 + channel);
+			mask.set(0xD0 + channel);
+		}
+		for (int channel = 0; channel < 9; channel++) {
+			mask.set(0xE0 + channel);
+		}
+		mask.set(0xF0);
+		return mask;
+	}();
+	constinit auto validSysExMask = toBitMask(validSysExMessage);
+	constinit auto validNoteMask = toBitMask(validNoteMessage);
+	constinit auto validVelocityMask = toBitMask(validVelocityMessage);
+	constinit auto validCCMask = toBitMask(validCCMessage);
+
+	bool MessageFilter::accept(const uint8_t* data, int size) {
+		auto result = MessageFilter::check(data, size);
+		this->count(result);
+		return result == Result::Passed;
+	}
+
+	bool MessageFilter::accept(const MidiMessage& message) {
+		return this->accept(message.getRawData(), message.getRawDataSize());
+	}
+
+	bool MessageFilter::accept(const Message& message) {
+		return this->accept(message.getRawData(), message.getRawDataSize());
+	}
+
+	int MessageFilter::filter(const MidiBuffer& input, MidiBuffer& output) {
+		int passed = 0;
+		for (const auto metadata : input) {
+			if (this->accept(metadata.data, metadata.numBytes)) {
+				output.addEvent(metadata.data, metadata.numBytes, metadata.samplePosition);
+				passed++;
+			}
+		}
+		return passed;
+	}
+
+	int MessageFilter::filter(std::vector<Message>& messages) {
+		auto end = std::remove_if(messages.begin(), messages.end(),
+			[this](const Message& message) { return !this->accept(message); });
+		messages.erase(end, messages.end());
+		return static_cast<int>(messages.size());
+	}
+
+	const MessageFilter::Counters& MessageFilter::getCounters() const {
+		return this->counters;
+	}
+
+	void MessageFilter::resetCounters() {
+		this->counters = Counters{};
+	}
+
+	bool MessageFilter::isCandidate(const uint8_t* data, int size) {
+		return MessageFilter::check(data, size) == Result::Passed;
+	}
+
+	void MessageFilter::count(Result result) {
+		switch (result) {
+		case Result::Passed:
+			this->counters.passed++;
+			break;
+		case Result::RejectedStatus:
+			this->counters.rejectedStatus++;
+			break;
+		case Result::RejectedSysEx:
+			this->counters.rejectedSysEx++;
+			break;
+		case Result::RejectedData:
+			this->counters.rejectedData++;
+			break;
+		}
+	}
+
+	MessageFilter::Result MessageFilter::check(const uint8_t* data, int size) {
+		if (size <= 0 || !validStatusMask.test(data[0])) {
+			return Result::RejectedStatus;
+		}
+
+		switch (data[0] & 0xF0) {
+		case 0xF0:
+			//F0, 4 header bytes, message type, ..., F7. The header is the one the library emits (all zero).
+			if (size < 1 + 5 + 1 || data[1] != 0x00 || data[2] != 0x00 || data[3] != 0x00 || data[4] != 0x00
+				|| data[5] >= 128 || !validSysExMask.test(data[5])) {
+				return Result::RejectedSysEx;
+			}
+			return Result::Passed;
+		case 0x80:
+		case 0x90:
+			if (size < 3 || data[1] >= 128 || data[2] >= 128
+				|| !validNoteMask.test(data[1]) || !validVelocityMask.test(data[2])) {
+				return Result::RejectedData;
+			}
+			return Result::Passed;
+		case 0xB0:
+			if (size < 3 || data[1] >= 128 || !validCCMask.test(data[1])) {
+				return Result::RejectedData;
+			}
+			return Result::Passed;
+		case 0xD0:
+			return (size >= 2) ? Result::Passed : Result::RejectedData;
+		case 0xE0:
+			return (size >= 3) ? Result::Passed : Result::RejectedData;
+		default:
+			return Result::RejectedStatus;
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/*****************************************************************//**
+ * \file	MessageFilter.h
+ * \brief	Early-reject prefilter of Mackie Control messages in mixed MIDI streams.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#import "MidiBuffer.h"
+
+namespace mackieControl {
+	/**
+	 * Prefilter which drops non Mackie Control traffic (clock, active sensing, MTC, other devices' system exclusive
+	 * messages) before the full decode.
+	 * The status byte is checked by a 256-bit mask, and the data bytes by 128-bit masks built from the validity tables.
+	 * The MIDI channels accepted are the ones of Message::isMackieControl(): all channels for note, controller and
+	 * channel pressure messages, channel 1-9 for pitch wheel messages. System exclusive messages must also carry the
+	 * 4 header bytes the library emits before the message type.
+	 */
+	class MessageFilter final {
+	public:
+		/**
+		 * Counters of filtered messages.
+		 */
+		struct Counters final {
+			uint64_t passed = 0;
+			uint64_t rejectedStatus = 0;
+			uint64_t rejectedSysEx = 0;
+			uint64_t rejectedData = 0;
+		};
+
+		MessageFilter() = default;
+
+		/**
+		 * Check the message and update the counters.
+		 * \param data			Raw MIDI Data Pointer
+		 * \param size			Raw MIDI Data Size
+		 */
+		bool accept(const uint8_t* data, int size);
+		/**
+		 * Check the message and update the counters.
+		 */
+		bool accept(const MidiMessage& message);
+		/**
+		 * Check the message and update the counters.
+		 */
+		bool accept(const Message& message);
+
+		/**
+		 * Copy all messages which may be Mackie Control messages to the output buffer.
+		 * \param input			Input Buffer
+		 * \param output		Output Buffer
+		 * \return	Number of Passed Messages
+		 */
+		int filter(const MidiBuffer& input, MidiBuffer& output);
+		/**
+		 * Remove all messages which are not Mackie Control messages from the vector.
+		 * \return	Number of Passed Messages
+		 */
+		int filter(std::vector<Message>& messages);
+
+		/**
+		 * Get the counters.
+		 */
+		const Counters& getCounters() const;
+		/**
+		 * Reset all counters to zero.
+		 */
+		void resetCounters();
+
+		/**
+		 * Check whether the message may be a Mackie Control message. This won't update any counters.
+		 * \param data			Raw MIDI Data Pointer
+		 * \param size			Raw MIDI Data Size
+		 */
+		static bool isCandidate(const uint8_t* data, int size);
+
+	private:
+		enum class Result {
+			Passed,
+			RejectedStatus,
+			RejectedSysEx,
+			RejectedData
+		};
+
+		Counters counters;
+
+		void count(Result result);
+		static Result check(const uint8_t* data, int size);
+	};
+}
@@ -0,0 +1,118 @@
+/*****************************************************************//**
+ * \file	MessageScheduler.cpp
+ * \brief	Sample-accurate scheduled output of Mackie Control messages.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageScheduler.h"
+
+namespace mackieControl {
+	void MessageScheduler::add(const Message& message, int64_t sampleTime) {
+		int slot = this->acquireSlot();
+		this->slots[slot] = message;
+		this->push(slot, sampleTime, false);
+	}
+
+	void MessageScheduler::add(Message&& message, int64_t sampleTime) {
+		int slot = this->acquireSlot();
+		this->slots[slot] = std::move(message);
+		this->push(slot, sampleTime, false);
+	}
+
+	void MessageScheduler::addAtOffset(const Message& message, int sampleOffset) {
+		this->add(message, this->blockStart + sampleOffset);
+	}
+
+	void MessageScheduler::addSpread(const Message& message, int64_t sampleTime) {
+		int slot = this->acquireSlot();
+		this->slots[slot] = message;
+		this->push(slot, sampleTime, true);
+	}
+
+	void MessageScheduler::renderBlock(MidiBuffer& buffer, int numSamples) {
+		int64_t blockEnd = this->blockStart + numSamples;
+
+		this->spreadEntries.clear();
+		while (!this->heap.empty() && this->heap.front().time < blockEnd) {
+			std::pop_heap(this->heap.begin(), this->heap.end(), MessageScheduler::later);
+			Entry entry = this->heap.back();
+			this->heap.pop_back();
+
+			if (entry.spread) {
+				this->spreadEntries.push_back(entry);
+				continue;
+			}
+
+			int offset = static_cast<int>(std::max<int64_t>(entry.time - this->blockStart, 0));
+			buffer.addEvent(this->slots[entry.slot].toMidi(), offset);
+			this->freeSlots.push_back(entry.slot);
+		}
+
+		//Bursty messages are evenly distributed in arrival order, so the link is never flooded at one sample.
+		//A message is never moved before its own time.
+		int spreadSize = static_cast<int>(this->spreadEntries.size());
+		for (int i = 0; i < spreadSize; i++) {
+			auto& entry = this->spreadEntries[i];
+			int offset = static_cast<int>(std::max<int64_t>(entry.time - this->blockStart,
+				(static_cast<int64_t>(i) * numSamples) / spreadSize));
+			buffer.addEvent(this->slots[entry.slot].toMidi(), offset);
+			this->freeSlots.push_back(entry.slot);
+		}
+
+		this->blockStart = blockEnd;
+	}
+
+	void MessageScheduler::clear() {
+		this->heap.clear();
+		this->spreadEntries.clear();
+		this->freeSlots.clear();
+		for (int i = static_cast<int>(this->slots.size()) - 1; i >= 0; i--) {
+			this->freeSlots.push_back(i);
+		}
+	}
+
+	void MessageScheduler::reserve(int size) {
+		this->heap.reserve(size);
+		this->spreadEntries.reserve(size);
+		this->freeSlots.reserve(size);
+		this->slots.reserve(size);
+	}
+
+	void MessageScheduler::setBlockStart(int64_t sampleTime) {
+		this->blockStart = sampleTime;
+	}
+
+	int64_t MessageScheduler::getBlockStart() const {
+		return this->blockStart;
+	}
+
+	int MessageScheduler::getNumPending() const {
+		return static_cast<int>(this->heap.size());
+	}
+
+	int MessageScheduler::acquireSlot() {
+		if (!this->freeSlots.empty()) {
+			int slot = this->freeSlots.back();
+			this->freeSlots.pop_back();
+			return slot;
+		}
+
+		this->slots.emplace_back();
+		return static_cast<int>(this->slots.size()) - 1;
+	}
+
+	void MessageScheduler::push(int slot, int64_t sampleTime, bool spread) {
+		this->heap.push_back({ sampleTime, this->order++, slot, spread });
+		std::push_heap(this->heap.begin(), this->heap.end(), MessageScheduler::later);
+	}
+
+	bool MessageScheduler::later(const Entry& a, const Entry& b) {
+		//Messages at the same time keep the order they were added
+		return (a.time != b.time) ? (a.time > b.time) : (a.order > b.order);
+	}
+}
@@ -0,0 +1,104 @@
+/*****************************************************************//**
+ * \file	MessageScheduler.h
+ * \brief	Sample-accurate scheduled output of Mackie Control messages.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#import "MidiBuffer.h"
+
+namespace mackieControl {
+	/**
+	 * Output timeline of Mackie Control messages in audio sample time.
+	 * Messages are kept in a binary heap ordered by time, and rendered block by block into a MIDI buffer.
+	 */
+	class MessageScheduler final {
+	public:
+		/**
+		 * Create an empty scheduler. The first block starts at sample 0.
+		 */
+		MessageScheduler() = default;
+
+		/**
+		 * Add a message at absolute sample time.
+		 * \param message		Message
+		 * \param sampleTime	Absolute Sample Time
+		 */
+		void add(const Message& message, int64_t sampleTime);
+		/**
+		 * Add a message at absolute sample time.
+		 * \param message		Message
+		 * \param sampleTime	Absolute Sample Time
+		 */
+		void add(Message&& message, int64_t sampleTime);
+		/**
+		 * Add a message at sample offset of the next block to render.
+		 * \param message		Message
+		 * \param sampleOffset	Sample Offset
+		 */
+		void addAtOffset(const Message& message, int sampleOffset);
+		/**
+		 * Add a message which can be moved later inside the block it falls in, but never before its own time.
+		 * Messages of this kind (such as meters) are spread evenly across the block instead of sent in a burst.
+		 * \param message		Message
+		 * \param sampleTime	Absolute Sample Time
+		 */
+		void addSpread(const Message& message, int64_t sampleTime);
+
+		/**
+		 * Render all messages due in the next block to the buffer and advance the timeline.
+		 * Messages scheduled before the block start are rendered at sample 0.
+		 * \param buffer		Output Buffer
+		 * \param numSamples	Block Size
+		 */
+		void renderBlock(MidiBuffer& buffer, int numSamples);
+
+		/**
+		 * Remove all pending messages.
+		 */
+		void clear();
+		/**
+		 * Reserve space for pending messages.
+		 */
+		void reserve(int size);
+
+		/**
+		 * Set the absolute sample time of the next block to render.
+		 */
+		void setBlockStart(int64_t sampleTime);
+		/**
+		 * Get the absolute sample time of the next block to render.
+		 */
+		int64_t getBlockStart() const;
+		/**
+		 * Get the number of pending messages.
+		 */
+		int getNumPending() const;
+
+	private:
+		struct Entry final {
+			int64_t time;
+			uint64_t order;
+			int slot;
+			bool spread;
+		};
+
+		std::vector<Entry> heap;
+		std::vector<Message> slots;
+		std::vector<int> freeSlots;
+		std::vector<Entry> spreadEntries;
+		int64_t blockStart = 0;
+		uint64_t order = 0;
+
+		int acquireSlot();
+		void push(int slot, int64_t sampleTime, bool spread);
+		static bool later(const Entry& a, const Entry& b);
+	};
+}
@@ -0,0 +1,122 @@
+/*****************************************************************//**
+ * \file	MessageTable.cpp
+ * \brief	Interned table of prebuilt Mackie Control feedback messages.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageTable.h"
+
+namespace mackieControl {
+	constexpr auto noteVelocities = std::to_array({
+		VelocityMessage::Off,
+		VelocityMessage::Flashing,
+		VelocityMessage::On
+		});
+
+	constinit auto noteBytes = [] {
+		std::array<std::array<uint8_t, 3>, 128 * 3> bytes{};
+		for (int note = 0; note < 128; note++) {
+			for (int vel = 0; vel < 3; vel++) {
+				bytes[note * 3 + vel] = { 0x90, static_cast<uint8_t>(note), static_cast<uint8_t>(noteVelocities[vel]) };
+			}
+		}
+		return bytes;
+	}();
+
+	constinit auto vPotLEDRingBytes = [] {
+		std::array<std::array<uint8_t, 3>, 8 * 128> bytes{};
+		for (int channel = 0; channel < 8; channel++) {
+			for (int value = 0; value < 128; value++) {
+				bytes[channel * 128 + value] = { 0xB0,
+					static_cast<uint8_t>(static_cast<int>(CCMessage::VPotLEDRing1) + channel), static_cast<uint8_t>(value) };
+			}
+		}
+		return bytes;
+	}();
+
+	constinit auto channelPressureBytes = [] {
+		std::array<std::array<uint8_t, 2>, 8 * 16> bytes{};
+		for (int i = 0; i < 8 * 16; i++) {
+			bytes[i] = { 0xD0, static_cast<uint8_t>(i) };
+		}
+		return bytes;
+	}();
+
+	const MessageTable& MessageTable::getInstance() {
+		static const MessageTable instance;
+		return instance;
+	}
+
+	const Message& MessageTable::getNote(NoteMessage type, VelocityMessage vel) const {
+		int index = MessageTable::toNoteIndex(type, vel);
+		return (index >= 0) ? this->notes[index] : this->empty;
+	}
+
+	const Message& MessageTable::getVPotLEDRing(int channel, int value) const {
+		int index = MessageTable::toRingIndex(channel, value);
+		return (index >= 0) ? this->rings[index] : this->empty;
+	}
+
+	const Message& MessageTable::getChannelPressure(int channel, int value) const {
+		int index = MessageTable::toMeterIndex(channel, value);
+		return (index >= 0) ? this->meters[index] : this->empty;
+	}
+
+	const uint8_t* MessageTable::getNoteBytes(NoteMessage type, VelocityMessage vel) {
+		int index = MessageTable::toNoteIndex(type, vel);
+		return (index >= 0) ? noteBytes[index].data() : nullptr;
+	}
+
+	const uint8_t* MessageTable::getVPotLEDRingBytes(int channel, int value) {
+		int index = MessageTable::toRingIndex(channel, value);
+		return (index >= 0) ? vPotLEDRingBytes[index].data() : nullptr;
+	}
+
+	const uint8_t* MessageTable::getChannelPressureBytes(int channel, int value) {
+		int index = MessageTable::toMeterIndex(channel, value);
+		return (index >= 0) ? channelPressureBytes[index].data() : nullptr;
+	}
+
+	MessageTable::MessageTable() {
+		for (int i = 0; i < static_cast<int>(this->notes.size()); i++) {
+			this->notes[i] = MidiMessage{ noteBytes[i].data(), static_cast<int>(noteBytes[i].size()) };
+		}
+		for (int i = 0; i < static_cast<int>(this->rings.size()); i++) {
+			this->rings[i] = MidiMessage{ vPotLEDRingBytes[i].data(), static_cast<int>(vPotLEDRingBytes[i].size()) };
+		}
+		for (int i = 0; i < static_cast<int>(this->meters.size()); i++) {
+			this->meters[i] = MidiMessage{ channelPressureBytes[i].data(), static_cast<int>(channelPressureBytes[i].size()) };
+		}
+	}
+
+	int MessageTable::toNoteIndex(NoteMessage type, VelocityMessage vel) {
+		int note = static_cast<int>(type);
+		if (note < 0 || note > 127) { return -1; }
+
+		switch (vel) {
+		case VelocityMessage::Off:
+			return note * 3;
+		case VelocityMessage::Flashing:
+			return note * 3 + 1;
+		case VelocityMessage::On:
+			return note * 3 + 2;
+		default:
+			return -1;
+		}
+	}
+
+	int MessageTable::toRingIndex(int channel, int value) {
+		if (channel < 1 || channel > 8 || value < 0 || value > 127) { return -1; }
+		return (channel - 1) * 128 + value;
+	}
+
+	int MessageTable::toMeterIndex(int channel, int value) {
+		if (channel < 1 || channel > 8 || value < 0 || value > 15) { return -1; }
+		return (channel - 1) * 16 + value;
+	}
+}
@@ -0,0 +1,82 @@
+/*****************************************************************//**
+ * \file	MessageTable.h
+ * \brief	Interned table of prebuilt Mackie Control feedback messages.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+
+namespace mackieControl {
+	/**
+	 * Read-only table of every LED, V-Pot LED ring and meter message.
+	 * The table is built once on first use and never changed after that, so it can be shared by any number of threads
+	 * without synchronization.
+	 * Out-of-range input gets an empty message (or nullptr bytes) instead of wrapping onto another channel or value.
+	 */
+	class MessageTable final {
+	public:
+		/**
+		 * Get the shared table.
+		 */
+		static const MessageTable& getInstance();
+
+		/**
+		 * Get the prebuilt message via MIDI note message.
+		 * \param type			Message Type
+		 * \param vel			Message On/Off Type
+		 * \return	The message, or an empty message if the input is out of range.
+		 */
+		const Message& getNote(NoteMessage type, VelocityMessage vel) const;
+		/**
+		 * Get the prebuilt V-Pot LED Ring message.
+		 * \param channel		Channel Number (1-8)
+		 * \param value			V-Pot LED Ring Value (see Message::toVPotLEDRingValue)
+		 * \return	The message, or an empty message if the input is out of range.
+		 */
+		const Message& getVPotLEDRing(int channel, int value) const;
+		/**
+		 * Get the prebuilt message via MIDI channel pressure message.
+		 * \param channel		Meter Channel Number (1-8)
+		 * \param value			Meter Value (0-15)
+		 * \return	The message, or an empty message if the input is out of range.
+		 */
+		const Message& getChannelPressure(int channel, int value) const;
+
+		/**
+		 * Get the encoded bytes of a message via MIDI note message.
+		 * \return	Data Pointer (3 bytes), or nullptr if the input is out of range.
+		 */
+		static const uint8_t* getNoteBytes(NoteMessage type, VelocityMessage vel);
+		/**
+		 * Get the encoded bytes of a V-Pot LED Ring message.
+		 * \return	Data Pointer (3 bytes), or nullptr if the input is out of range.
+		 */
+		static const uint8_t* getVPotLEDRingBytes(int channel, int value);
+		/**
+		 * Get the encoded bytes of a message via MIDI channel pressure message.
+		 * \return	Data Pointer (2 bytes), or nullptr if the input is out of range.
+		 */
+		static const uint8_t* getChannelPressureBytes(int channel, int value);
+
+	private:
+		MessageTable();
+		MessageTable(const MessageTable&) = delete;
+		MessageTable& operator=(const MessageTable&) = delete;
+
+		static int toNoteIndex(NoteMessage type, VelocityMessage vel);
+		static int toRingIndex(int channel, int value);
+		static int toMeterIndex(int channel, int value);
+
+		std::array<Message, 128 * 3> notes;
+		std::array<Message, 8 * 128> rings;
+		std::array<Message, 8 * 16> meters;
+		Message empty;
+	};
+}
@@ -0,0 +1,176 @@
+/*****************************************************************//**
+ * \file	MessageUMP.cpp
+ * \brief	Universal MIDI Packet encoder and decoder of Mackie Control messages.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageUMP.h"
+
+namespace mackieControl {
+	enum class UMPMessageType : uint8_t {
+		MIDI1ChannelVoice = 2,
+		Data64 = 3
+	};
+
+	enum class SysEx7Status : uint8_t {
+		Complete = 0,
+		Start,
+		Continue,
+		End
+	};
+
+	constexpr int sysEx7BytesPerPacket = 6;
+
+	UMPEncoder::UMPEncoder(uint8_t group)
+		: group(group & 0x0F) {}
+
+	void UMPEncoder::encode(const Message& message, std::vector<uint32_t>& words) const {
+		this->encode(message.getRawData(), message.getRawDataSize(), words);
+	}
+
+	void UMPEncoder::encode(const uint8_t* data, int size, std::vector<uint32_t>& words) const {
+		if (size <= 0) { return; }
+
+		if (data[0] == 0xF0) {
+			//Strip F0 and F7, UMP system exclusive packets carry the payload only
+			int payloadSize = size - 1 - ((data[size - 1] == 0xF7) ? 1 : 0);
+			this->encodeSysEx7(payloadSize, [data](int i) { return data[1 + i]; }, words);
+			return;
+		}
+
+		if (data[0] >= 0x80 && data[0] < 0xF0) {
+			words.push_back((static_cast<uint32_t>(UMPMessageType::MIDI1ChannelVoice) << 28)
+				| (static_cast<uint32_t>(this->group) << 24)
+				| (static_cast<uint32_t>(data[0]) << 16)
+				| ((size > 1) ? (static_cast<uint32_t>(data[1]) << 8) : 0)
+				| ((size > 2) ? static_cast<uint32_t>(data[2]) : 0));
+		}
+	}
+
+	void UMPEncoder::encodeLCD(uint8_t place, const char* data, int size, std::vector<uint32_t>& words) const {
+		//Same layout as Message::createLCD: 4 header bytes, message type, place, data
+		this->encodeSysEx7(5 + 1 + size, [place, data](int i) -> uint8_t {
+			if (i < 4) { return 0; }
+			if (i == 4) { return static_cast<uint8_t>(SysExMessage::LCD); }
+			if (i == 5) { return place; }
+			return static_cast<uint8_t>(data[i - 6]);
+			}, words);
+	}
+
+	int UMPEncoder::getNumWords(const Message& message) {
+		int size = message.getRawDataSize();
+		if (size <= 0) { return 0; }
+
+		auto data = message.getRawData();
+		if (data[0] == 0xF0) {
+			int payloadSize = size - 1 - ((data[size - 1] == 0xF7) ? 1 : 0);
+			int packets = std::max((payloadSize + sysEx7BytesPerPacket - 1) / sysEx7BytesPerPacket, 1);
+			return packets * 2;
+		}
+
+		//Other system messages are not encoded
+		return (data[0] >= 0x80 && data[0] < 0xF0) ? 1 : 0;
+	}
+
+	template <typename ByteGetter>
+	void UMPEncoder::encodeSysEx7(int size, ByteGetter getByte, std::vector<uint32_t>& words) const {
+		int packets = std::max((size + sysEx7BytesPerPacket - 1) / sysEx7BytesPerPacket, 1);
+		words.reserve(words.size() + packets * 2);
+
+		for (int packet = 0, pos = 0; packet < packets; packet++) {
+			SysEx7Status status = (packets == 1) ? SysEx7Status::Complete
+				: (packet == 0) ? SysEx7Status::Start
+				: (packet == packets - 1) ? SysEx7Status::End
+				: SysEx7Status::Continue;
+			int count = std::min(size - pos, sysEx7BytesPerPacket);
+
+			uint8_t bytes[sysEx7BytesPerPacket] = {};
+			for (int i = 0; i < count; i++) {
+				bytes[i] = getByte(pos + i) & 0x7F;
+			}
+			pos += count;
+
+			words.push_back((static_cast<uint32_t>(UMPMessageType::Data64) << 28)
+				| (static_cast<uint32_t>(this->group) << 24)
+				| (static_cast<uint32_t>(status) << 20)
+				| (static_cast<uint32_t>(count) << 16)
+				| (static_cast<uint32_t>(bytes[0]) << 8)
+				| static_cast<uint32_t>(bytes[1]));
+			words.push_back((static_cast<uint32_t>(bytes[2]) << 24)
+				| (static_cast<uint32_t>(bytes[3]) << 16)
+				| (static_cast<uint32_t>(bytes[4]) << 8)
+				| static_cast<uint32_t>(bytes[5]));
+		}
+	}
+
+	UMPDecoder::UMPDecoder(uint8_t group)
+		: group(group & 0x0F) {}
+
+	int UMPDecoder::decode(const uint32_t* words, int numWords, std::vector<Message>& messages) {
+		int pos = 0;
+		while (pos < numWords) {
+			uint32_t first = words[pos];
+			int packetSize = UMPDecoder::getPacketSize(first);
+			if (pos + packetSize > numWords) { break; }
+
+			auto type = static_cast<UMPMessageType>(first >> 28);
+			uint8_t packetGroup = (first >> 24) & 0x0F;
+
+			if (packetGroup == this->group && type == UMPMessageType::MIDI1ChannelVoice) {
+				uint8_t bytes[3] = {
+					static_cast<uint8_t>(first >> 16),
+					static_cast<uint8_t>((first >> 8) & 0x7F),
+					static_cast<uint8_t>(first & 0x7F) };
+				uint8_t kind = bytes[0] & 0xF0;
+				int size = (kind == 0xC0 || kind == 0xD0) ? 2 : 3;
+				messages.emplace_back(MidiMessage{ bytes, size });
+			}
+			else if (packetGroup == this->group && type == UMPMessageType::Data64) {
+				auto status = static_cast<SysEx7Status>((first >> 20) & 0x0F);
+				int count = std::min<int>((first >> 16) & 0x0F, sysEx7BytesPerPacket);
+				uint32_t second = words[pos + 1];
+				uint8_t bytes[sysEx7BytesPerPacket] = {
+					static_cast<uint8_t>((first >> 8) & 0x7F), static_cast<uint8_t>(first & 0x7F),
+					static_cast<uint8_t>((second >> 24) & 0x7F), static_cast<uint8_t>((second >> 16) & 0x7F),
+					static_cast<uint8_t>((second >> 8) & 0x7F), static_cast<uint8_t>(second & 0x7F) };
+
+				if (status == SysEx7Status::Complete || status == SysEx7Status::Start) {
+					this->sysExBuffer.clear();
+					this->sysExBuffer.push_back(0xF0);
+					this->inSysEx = true;
+				}
+
+				if (this->inSysEx) {
+					this->sysExBuffer.insert(this->sysExBuffer.end(), bytes, bytes + count);
+
+					if (status == SysEx7Status::Complete || status == SysEx7Status::End) {
+						this->sysExBuffer.push_back(0xF7);
+						messages.emplace_back(MidiMessage{
+							this->sysExBuffer.data(), static_cast<int>(this->sysExBuffer.size()) });
+						this->inSysEx = false;
+					}
+				}
+			}
+
+			pos += packetSize;
+		}
+		return pos;
+	}
+
+	void UMPDecoder::reset() {
+		this->sysExBuffer.clear();
+		this->inSysEx = false;
+	}
+
+	int UMPDecoder::getPacketSize(uint32_t firstWord) {
+		constexpr auto packetSizes = std::to_array({
+			1, 1, 1, 2, 2, 4, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4
+			});
+		return packetSizes[firstWord >> 28];
+	}
+}
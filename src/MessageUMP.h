@@ -0,0 +1,103 @@
+/*****************************************************************//**
+ * \file	MessageUMP.h
+ * \brief	Universal MIDI Packet encoder and decoder of Mackie Control messages.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+
+namespace mackieControl {
+	/**
+	 * Encode Mackie Control messages to Universal MIDI Packet words.
+	 * Channel voice messages are encoded as MIDI 1.0 channel voice messages in UMP (message type 2), system exclusive
+	 * messages as Data 64 system exclusive 7-bit packets (message type 3). Other system messages are not part of
+	 * Mackie Control and are not encoded.
+	 */
+	class UMPEncoder final {
+	public:
+		/**
+		 * Create an encoder.
+		 * \param group			UMP Group (0-15)
+		 */
+		explicit UMPEncoder(uint8_t group = 0);
+
+		/**
+		 * Append the UMP words of the message.
+		 * \param message		Message
+		 * \param words			Output Words
+		 */
+		void encode(const Message& message, std::vector<uint32_t>& words) const;
+		/**
+		 * Append the UMP words of raw MIDI data.
+		 * \param data			Raw MIDI Data Pointer
+		 * \param size			Raw MIDI Data Size
+		 * \param words			Output Words
+		 */
+		void encode(const uint8_t* data, int size, std::vector<uint32_t>& words) const;
+		/**
+		 * Append the UMP words of an LCD message without creating the message first.
+		 * \param place			Line Place
+		 * \param data			Data Pointer
+		 * \param size			Data Size
+		 * \param words			Output Words
+		 */
+		void encodeLCD(uint8_t place, const char* data, int size, std::vector<uint32_t>& words) const;
+
+		/**
+		 * Get the number of UMP words of the message, which is the number of words encode() appends.
+		 */
+		static int getNumWords(const Message& message);
+
+	private:
+		uint8_t group;
+
+		template <typename ByteGetter>
+		void encodeSysEx7(int size, ByteGetter getByte, std::vector<uint32_t>& words) const;
+	};
+
+	/**
+	 * Decode Universal MIDI Packet words to Mackie Control messages.
+	 * The decoder keeps partial system exclusive messages between calls, so a word stream can be decoded in chunks.
+	 * Message types other than MIDI 1.0 channel voice and Data 64 are skipped.
+	 */
+	class UMPDecoder final {
+	public:
+		/**
+		 * Create a decoder.
+		 * \param group			UMP Group (0-15)
+		 */
+		explicit UMPDecoder(uint8_t group = 0);
+
+		/**
+		 * Decode the words and append all complete messages.
+		 * \param words			Words Pointer
+		 * \param numWords		Words Size
+		 * \param messages		Output Messages
+		 * \return	Number of Words Consumed. Incomplete packets at the end are not consumed.
+		 */
+		int decode(const uint32_t* words, int numWords, std::vector<Message>& messages);
+
+		/**
+		 * Drop the partial system exclusive message.
+		 */
+		void reset();
+
+		/**
+		 * Get the number of words of the packet.
+		 * \param firstWord		First Word of the Packet
+		 */
+		static int getPacketSize(uint32_t firstWord);
+
+	private:
+		uint8_t group;
+		std::vector<uint8_t> sysExBuffer;
+		bool inSysEx = false;
+	};
+}
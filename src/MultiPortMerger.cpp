@@ -0,0 +1,211 @@
+/*****************************************************************//**
+ * \file	MultiPortMerger.cpp
+ * \brief	Timestamp ordered merge of input from multiple surface ports.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MultiPortMerger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mackieControl {
+	MultiPortMerger::MultiPortMerger(int portNum, double maxDelayMs, int capacity, double resolutionMs)
+		: maxDelayMs(std::max(maxDelayMs, 0.0)), resolutionMs(std::max(resolutionMs, 0.001)) {
+		uint32_t size = 1;
+		while (size < static_cast<uint32_t>(std::max(capacity, 1))) { size <<= 1; }
+		this->mask = size - 1;
+
+		for (int i = 0; i < portNum; i++) {
+			auto port = std::make_unique<Port>();
+			port->slots = std::make_unique<Slot[]>(size);
+			this->ports.push_back(std::move(port));
+		}
+
+		//The wheel covers a few reordering delays, later events wait in the overflow list
+		std::size_t bucketNum = 64;
+		double span = 4 * this->maxDelayMs / this->resolutionMs;
+		while (bucketNum < span) { bucketNum <<= 1; }
+		this->wheel.resize(bucketNum);
+	}
+
+	bool MultiPortMerger::push(int port, const Message& message, double timeMs) {
+		if (port < 0 || port >= this->getPortNum()) { return false; }
+
+		auto& ring = *(this->ports[port]);
+		uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+		uint32_t head = ring.head.load(std::memory_order_acquire);
+		if (tail - head > this->mask) {
+			ring.dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		auto& slot = ring.slots[tail & this->mask];
+		slot.time = timeMs;
+		slot.message = message;
+		ring.tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	int MultiPortMerger::pop(double timeMs, std::vector<Event>& events) {
+		this->drain();
+		if (!this->started) { return 0; }
+
+		//A bucket is released once all of its time range is older than the delay
+		return this->release(this->toTick(timeMs - this->maxDelayMs) - 1, events);
+	}
+
+	int MultiPortMerger::flush(std::vector<Event>& events) {
+		this->drain();
+		if (!this->started) { return 0; }
+
+		return this->release(this->newestTick, events);
+	}
+
+	int MultiPortMerger::getPortNum() const {
+		return static_cast<int>(this->ports.size());
+	}
+
+	MultiPortMerger::Counters MultiPortMerger::getCounters() const {
+		Counters result = this->counters;
+		for (auto& port : this->ports) {
+			result.dropped += port->dropped.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+	int MultiPortMerger::getStrip(const Message& message) {
+		if (message.isNote()) {
+			auto [type, vel] = message.getNoteData();
+			int note = static_cast<int>(type);
+			if (note <= static_cast<int>(NoteMessage::VSelectCh8)) {
+				return note % ChannelNum;
+			}
+			if (note >= static_cast<int>(NoteMessage::FaderTouchCh1) && note <= static_cast<int>(NoteMessage::FaderTouchCh8)) {
+				return note - static_cast<int>(NoteMessage::FaderTouchCh1);
+			}
+			return -1;
+		}
+		if (message.isCC()) {
+			auto [type, value] = message.getCCData();
+			if (type >= CCMessage::VPot1 && type <= CCMessage::VPot8) {
+				return static_cast<int>(type) - static_cast<int>(CCMessage::VPot1);
+			}
+			return -1;
+		}
+		if (message.isPitchWheel()) {
+			auto [channel, value] = message.getPitchWheelData();
+			return (channel <= ChannelNum) ? (channel - 1) : -1;
+		}
+		return -1;
+	}
+
+	void MultiPortMerger::drain() {
+		for (int i = 0; i < this->getPortNum(); i++) {
+			auto& ring = *(this->ports[i]);
+			uint32_t head = ring.head.load(std::memory_order_relaxed);
+			uint32_t tail = ring.tail.load(std::memory_order_acquire);
+
+			for (; head != tail; head++) {
+				auto& slot = ring.slots[head & this->mask];
+
+				Event event;
+				event.time = slot.time;
+				event.device = i;
+				event.message = std::move(slot.message);
+				int strip = MultiPortMerger::getStrip(event.message);
+				event.strip = (strip >= 0) ? (ChannelNum * i + strip) : -1;
+
+				this->insert(std::move(event));
+			}
+			ring.head.store(head, std::memory_order_release);
+		}
+	}
+
+	void MultiPortMerger::insert(Event&& event) {
+		int64_t tick = this->toTick(event.time);
+		if (!this->started) {
+			this->releasedTick = tick;
+			this->newestTick = tick;
+			this->started = true;
+		}
+
+		//Events of released buckets go to the next bucket
+		if (tick < this->releasedTick) {
+			tick = this->releasedTick;
+			this->counters.late++;
+		}
+		this->newestTick = std::max(this->newestTick, tick);
+
+		//Events too far ahead for the wheel wait in the overflow list until the wheel reaches them
+		int64_t bucketNum = static_cast<int64_t>(this->wheel.size());
+		if (tick >= this->releasedTick + bucketNum) {
+			auto it = std::upper_bound(this->overflow.begin(), this->overflow.end(), event.time,
+				[](double time, const Event& e) { return time < e.time; });
+			this->overflow.insert(it, std::move(event));
+			return;
+		}
+
+		this->insertToWheel(std::move(event), tick);
+	}
+
+	void MultiPortMerger::insertToWheel(Event&& event, int64_t tick) {
+		//Buckets are short, so a sorted insert from the back is cheap
+		int64_t bucketNum = static_cast<int64_t>(this->wheel.size());
+		auto& bucket = this->wheel[static_cast<std::size_t>(tick & (bucketNum - 1))];
+		auto it = std::upper_bound(bucket.begin(), bucket.end(), event.time,
+			[](double time, const Event& e) { return time < e.time; });
+		bucket.insert(it, std::move(event));
+		this->pending++;
+	}
+
+	void MultiPortMerger::refill() {
+		int64_t end = this->releasedTick + static_cast<int64_t>(this->wheel.size());
+		while (!this->overflow.empty()) {
+			int64_t tick = this->toTick(this->overflow.front().time);
+			if (tick >= end) { break; }
+
+			this->insertToWheel(std::move(this->overflow.front()), tick);
+			this->overflow.pop_front();
+		}
+	}
+
+	int MultiPortMerger::release(int64_t lastTick, std::vector<Event>& events) {
+		if (lastTick < this->releasedTick) { return 0; }
+
+		int count = 0;
+		int64_t bucketNum = static_cast<int64_t>(this->wheel.size());
+		while (this->releasedTick <= lastTick) {
+			this->refill();
+
+			//Skip the empty part of the wheel, up to where the first overflow event comes into range
+			if (this->pending == 0) {
+				if (this->overflow.empty()) { break; }
+				int64_t next = this->toTick(this->overflow.front().time) - bucketNum + 1;
+				this->releasedTick = std::min(next, lastTick + 1);
+				continue;
+			}
+
+			auto& bucket = this->wheel[static_cast<std::size_t>(this->releasedTick & (bucketNum - 1))];
+			for (auto& event : bucket) {
+				events.push_back(std::move(event));
+			}
+			count += static_cast<int>(bucket.size());
+			this->pending -= static_cast<int>(bucket.size());
+			bucket.clear();
+			this->releasedTick++;
+		}
+		this->releasedTick = std::max(this->releasedTick, lastTick + 1);
+
+		this->counters.merged += count;
+		return count;
+	}
+
+	int64_t MultiPortMerger::toTick(double timeMs) const {
+		return static_cast<int64_t>(std::floor(timeMs / this->resolutionMs));
+	}
+}
@@ -0,0 +1,143 @@
+/*****************************************************************//**
+ * \file	MultiPortMerger.h
+ * \brief	Timestamp ordered merge of input from multiple surface ports.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#include <atomic>
+#include <memory>
+#include <deque>
+
+namespace mackieControl {
+	/**
+	 * Merge the input of several Mackie Control devices (such as a main unit and its extenders) into one stream
+	 * ordered by timestamp.
+	 * Each port has a lock-free single producer, single consumer ring, so every port can be pushed from its own MIDI
+	 * callback thread. The consumer thread moves the events into a timing wheel, and releases them in timestamp order
+	 * once they are older than the reordering delay. Pushing, wheeling and releasing an event all take constant time,
+	 * no matter how many ports there are. Events too far ahead for the wheel wait in a time-sorted overflow list.
+	 * All timestamps must be taken from the same clock.
+	 */
+	class MultiPortMerger final {
+	public:
+		/**
+		 * Number of channel strips of each device.
+		 */
+		static constexpr int ChannelNum = 8;
+
+		/**
+		 * Merged input event.
+		 */
+		struct Event final {
+			/**
+			 * Timestamp (ms).
+			 */
+			double time = 0;
+			/**
+			 * Device (Port) Index.
+			 */
+			int device = 0;
+			/**
+			 * Global strip index (ChannelNum * device + strip of the device), or -1 if the message is not of a strip.
+			 */
+			int strip = -1;
+			Message message;
+		};
+
+		/**
+		 * Counters of the merger.
+		 */
+		struct Counters final {
+			uint64_t merged = 0;
+			uint64_t dropped = 0;
+			uint64_t late = 0;
+		};
+
+		/**
+		 * Create a merger.
+		 * \param portNum		Number of Ports
+		 * \param maxDelayMs	Reordering Delay (ms)
+		 * \param capacity		Ring Capacity of Each Port (rounded up to a power of 2)
+		 * \param resolutionMs	Timing Wheel Resolution (ms)
+		 */
+		MultiPortMerger(int portNum, double maxDelayMs = 2, int capacity = 1024, double resolutionMs = 0.25);
+
+		/**
+		 * Push a message received from a port. Each port may be pushed from one thread only.
+		 * \param port			Port Index
+		 * \param message		Message
+		 * \param timeMs		Receive Time (ms)
+		 * \return	Whether the message was queued. The message is dropped if the ring of the port is full.
+		 */
+		bool push(int port, const Message& message, double timeMs);
+
+		/**
+		 * Take all events which are older than the reordering delay, in timestamp order. Call from one consumer thread.
+		 * \param timeMs		Current Time (ms)
+		 * \param events		Output Events
+		 * \return	Number of Events Released
+		 */
+		int pop(double timeMs, std::vector<Event>& events);
+		/**
+		 * Take all queued events in timestamp order, without waiting for the reordering delay.
+		 * \param events		Output Events
+		 * \return	Number of Events Released
+		 */
+		int flush(std::vector<Event>& events);
+
+		/**
+		 * Get the number of ports.
+		 */
+		int getPortNum() const;
+		/**
+		 * Get the counters. Call from the consumer thread.
+		 */
+		Counters getCounters() const;
+
+		/**
+		 * Get the strip of the device a message is of.
+		 * \return	Strip Index (0-7), or -1 if the message is not of a strip.
+		 */
+		static int getStrip(const Message& message);
+
+	private:
+		struct Slot final {
+			double time = 0;
+			Message message;
+		};
+
+		struct Port final {
+			alignas(64) std::atomic<uint32_t> head{ 0 };
+			alignas(64) std::atomic<uint32_t> tail{ 0 };
+			alignas(64) std::atomic<uint64_t> dropped{ 0 };
+			std::unique_ptr<Slot[]> slots;
+		};
+
+		std::vector<std::unique_ptr<Port>> ports;
+		uint32_t mask;
+		double maxDelayMs, resolutionMs;
+
+		std::vector<std::vector<Event>> wheel;
+		std::deque<Event> overflow;
+		int64_t releasedTick = 0;
+		int64_t newestTick = 0;
+		bool started = false;
+		int pending = 0;
+		Counters counters;
+
+		void drain();
+		void insert(Event&& event);
+		void insertToWheel(Event&& event, int64_t tick);
+		void refill();
+		int release(int64_t lastTick, std::vector<Event>& events);
+		int64_t toTick(double timeMs) const;
+	};
+}
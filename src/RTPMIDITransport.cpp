@@ -0,0 +1,360 @@
+/*****************************************************************//**
+ * \file	RTPMIDITransport.cpp
+ * \brief	Mackie Control messages over UDP in RTP-MIDI packets.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "RTPMIDITransport.h"
+#include <random>
+
+namespace mackieControl {
+	RTPMIDITransport::RTPMIDITransport()
+		: RTPMIDITransport(Config{}) {}
+
+	RTPMIDITransport::RTPMIDITransport(const Config& config)
+		: config(config) {
+		this->config.maxPayloadSize = std::clamp(this->config.maxPayloadSize, 16, 4095);
+		if (this->config.SSRC == 0) {
+			std::random_device device;
+			this->config.SSRC = static_cast<uint32_t>(device()) | 1;
+		}
+
+		this->commands.reserve(this->config.maxPayloadSize);
+		this->packet.reserve(HeaderSize + 2 + this->config.maxPayloadSize);
+		this->receiveBuffer.resize(MaxPacketSize);
+	}
+
+	bool RTPMIDITransport::bind(int localPort, const String& localAddress) {
+		this->bound = localAddress.isEmpty()
+			? this->socket.bindToPort(localPort)
+			: this->socket.bindToPort(localPort, localAddress);
+		return this->bound;
+	}
+
+	int RTPMIDITransport::getBoundPort() const {
+		return this->bound ? this->socket.getBoundPort() : -1;
+	}
+
+	void RTPMIDITransport::setPeer(const String& host, int port) {
+		this->peerHost = host;
+		this->peerPort = port;
+	}
+
+	bool RTPMIDITransport::send(const Message& message, double timeMs) {
+		return this->send(message.getRawData(), message.getRawDataSize(), timeMs);
+	}
+
+	bool RTPMIDITransport::send(const uint8_t* data, int size, double timeMs) {
+		if (!data || size <= 0 || !(data[0] & 0x80)) { return false; }
+		if (size + 5 <= this->config.maxPayloadSize) {
+			return this->addCommand(data, size, timeMs);
+		}
+
+		//Only system exclusive messages can be longer than a packet, they are sent as segments
+		if (data[0] != 0xF0 || data[size - 1] != 0xF7) { return false; }
+
+		bool result = true;
+		int segmentSize = this->config.maxPayloadSize - 6;
+		for (int pos = 1; pos < size - 1; pos += segmentSize) {
+			int bodySize = std::min(segmentSize, size - 1 - pos);
+			bool last = pos + bodySize >= size - 1;
+
+			//F0 ... F0 first, F7 ... F0 middle, F7 ... F7 last
+			auto& segment = this->segment;
+			segment.clear();
+			segment.push_back((pos == 1) ? 0xF0 : 0xF7);
+			segment.insert(segment.end(), data + pos, data + pos + bodySize);
+			segment.push_back(last ? 0xF7 : 0xF0);
+
+			result = this->addCommand(segment.data(), static_cast<int>(segment.size()), timeMs) && result;
+		}
+		return result;
+	}
+
+	bool RTPMIDITransport::addCommand(const uint8_t* data, int size, double timeMs) {
+		bool result = true;
+		if (this->batchSize > 0 && static_cast<int>(this->commands.size()) + size + 4 > this->config.maxPayloadSize) {
+			result = this->flush();
+		}
+
+		if (this->batchSize == 0) {
+			this->batchStart = this->batchLast = timeMs;
+		}
+		else {
+			//Delta time of the command in RTP clock, as a variable length number
+			double ticks = std::max(timeMs - this->batchLast, 0.0) * ClockRate / 1000;
+			uint32_t delta = std::min(static_cast<uint32_t>(ticks + 0.5), 0x0FFFFFFFu);
+			this->batchLast = timeMs;
+
+			for (int shift = 21; shift > 0; shift -= 7) {
+				if (delta >= (1u << shift)) {
+					this->commands.push_back(static_cast<uint8_t>(0x80 | ((delta >> shift) & 0x7F)));
+				}
+			}
+			this->commands.push_back(static_cast<uint8_t>(delta & 0x7F));
+		}
+
+		//Channel messages share the status byte with the previous command
+		uint8_t status = data[0];
+		int skip = (status < 0xF0 && status == this->runningStatus) ? 1 : 0;
+		this->commands.insert(this->commands.end(), data + skip, data + size);
+		this->runningStatus = status < 0xF0 ? status : 0;
+		this->batchSize++;
+
+		if (this->config.batchWindowMs <= 0) {
+			result = this->flush() && result;
+		}
+		return result;
+	}
+
+	bool RTPMIDITransport::advance(double timeMs) {
+		if (this->batchSize == 0 || timeMs < this->getNextDeadline()) { return true; }
+		return this->flush();
+	}
+
+	bool RTPMIDITransport::flush() {
+		if (this->batchSize == 0) { return true; }
+
+		auto& packet = this->packet;
+		packet.clear();
+
+		uint16_t sequence = this->sendSequence++;
+		uint32_t timestamp = static_cast<uint32_t>(static_cast<int64_t>(this->batchStart * ClockRate / 1000));
+		uint32_t SSRC = this->config.SSRC;
+		packet.push_back(0x80);
+		packet.push_back(PayloadType);
+		packet.push_back(static_cast<uint8_t>(sequence >> 8));
+		packet.push_back(static_cast<uint8_t>(sequence));
+		for (int shift = 24; shift >= 0; shift -= 8) { packet.push_back(static_cast<uint8_t>(timestamp >> shift)); }
+		for (int shift = 24; shift >= 0; shift -= 8) { packet.push_back(static_cast<uint8_t>(SSRC >> shift)); }
+
+		//MIDI command section header: B (long header), J = 0, Z = 0, P = 0, LEN
+		int length = static_cast<int>(this->commands.size());
+		if (length > 15) {
+			packet.push_back(static_cast<uint8_t>(0x80 | (length >> 8)));
+			packet.push_back(static_cast<uint8_t>(length));
+		}
+		else {
+			packet.push_back(static_cast<uint8_t>(length));
+		}
+		packet.insert(packet.end(), this->commands.begin(), this->commands.end());
+
+		int messageNum = this->batchSize;
+		this->commands.clear();
+		this->batchSize = 0;
+		this->runningStatus = 0;
+
+		if (!this->bound || this->peerPort <= 0) { return false; }
+		int size = static_cast<int>(packet.size());
+		if (this->socket.write(this->peerHost, this->peerPort, packet.data(), size) != size) { return false; }
+
+		//Only packets which were written are counted
+		this->counters.packetsSent++;
+		this->counters.messagesSent += messageNum;
+		this->counters.bytesSent += size;
+		return true;
+	}
+
+	double RTPMIDITransport::getNextDeadline() const {
+		if (this->batchSize == 0) { return -1; }
+		return this->batchStart + std::max(this->config.batchWindowMs, 0.0);
+	}
+
+	int RTPMIDITransport::receive(std::vector<Message>& messages, int timeoutMs) {
+		if (!this->bound) { return 0; }
+
+		int count = 0;
+		int timeout = timeoutMs;
+		while (this->socket.waitUntilReady(true, timeout) > 0) {
+			int size = this->socket.read(this->receiveBuffer.data(), MaxPacketSize, false);
+			if (size <= 0) { break; }
+
+			count += std::max(this->decode(this->receiveBuffer.data(), size, messages), 0);
+			timeout = 0;
+		}
+		return count;
+	}
+
+	int RTPMIDITransport::decode(const uint8_t* packet, int size, std::vector<Message>& messages) {
+		if (!packet || size < HeaderSize + 1 || (packet[0] & 0xC0) != 0x80) {
+			this->counters.packetsDropped++;
+			return -1;
+		}
+
+		//Padding, CSRC list and header extension
+		int end = size;
+		if (packet[0] & 0x20) { end -= packet[size - 1]; }
+		int pos = HeaderSize + (packet[0] & 0x0F) * 4;
+		if ((packet[0] & 0x10) && pos + 4 <= end) {
+			pos += 4 + ((packet[pos + 2] << 8) | packet[pos + 3]) * 4;
+		}
+		if (pos >= end) {
+			this->counters.packetsDropped++;
+			return -1;
+		}
+
+		uint16_t sequence = static_cast<uint16_t>((packet[2] << 8) | packet[3]);
+		uint32_t SSRC = (static_cast<uint32_t>(packet[8]) << 24) | (packet[9] << 16) | (packet[10] << 8) | packet[11];
+		if (this->receiving && SSRC == this->receiveSSRC) {
+			auto gap = static_cast<int16_t>(sequence - this->receiveSequence);
+			if (gap < 0) {
+				this->counters.packetsDropped++;
+				return -1;
+			}
+			if (gap > 0) {
+				//The lost packets may have held segments of a system exclusive message, which can't be completed now
+				this->counters.packetsLost += gap;
+				this->inSysEx = false;
+				this->sysExBuffer.clear();
+			}
+		}
+		else {
+			//A new sender, partial data of the old one is dropped
+			this->receiving = true;
+			this->receiveSSRC = SSRC;
+			this->inSysEx = false;
+			this->sysExBuffer.clear();
+		}
+		this->receiveSequence = static_cast<uint16_t>(sequence + 1);
+
+		uint8_t flags = packet[pos++];
+		int length = flags & 0x0F;
+		if (flags & 0x80) {
+			if (pos >= end) {
+				this->counters.packetsDropped++;
+				return -1;
+			}
+			length = (length << 8) | packet[pos++];
+		}
+		length = std::min(length, end - pos);
+
+		this->counters.packetsReceived++;
+		int count = this->decodeCommands(packet + pos, length, flags & 0x20, messages);
+		this->counters.messagesReceived += count;
+		return count;
+	}
+
+	const RTPMIDITransport::Counters& RTPMIDITransport::getCounters() const {
+		return this->counters;
+	}
+
+	void RTPMIDITransport::resetCounters() {
+		this->counters = Counters{};
+	}
+
+	void RTPMIDITransport::reset() {
+		this->commands.clear();
+		this->batchSize = 0;
+		this->runningStatus = 0;
+		this->sysExBuffer.clear();
+		this->inSysEx = false;
+		this->receiving = false;
+	}
+
+	int RTPMIDITransport::decodeCommands(const uint8_t* data, int size, bool firstHasDelta, std::vector<Message>& messages) {
+		int count = 0;
+		int pos = 0;
+		uint8_t running = 0;
+		bool first = true;
+
+		while (pos < size) {
+			//Delta time, which is only used for ordering here
+			if (!first || firstHasDelta) {
+				for (int i = 0; i < 4 && pos < size; i++) {
+					if (!(data[pos++] & 0x80)) { break; }
+				}
+			}
+			first = false;
+			if (pos >= size) { break; }
+
+			uint8_t status = data[pos];
+
+			//System exclusive segments: F0 ... F7 complete, F0 ... F0 first, F7 ... F0 middle, F7 ... F7 last, F7 ... F4 cancel
+			//A segment whose start was lost is skipped
+			if (status == 0xF0 || status == 0xF7) {
+				bool valid = (status == 0xF0) || this->inSysEx;
+				if (status == 0xF0) {
+					this->sysExBuffer.assign(1, 0xF0);
+				}
+				pos++;
+
+				int start = pos;
+				while (pos < size && data[pos] < 0x80) { pos++; }
+				if (valid) {
+					this->sysExBuffer.insert(this->sysExBuffer.end(), data + start, data + pos);
+				}
+				if (pos >= size) {
+					this->inSysEx = false;
+					break;
+				}
+
+				uint8_t terminator = data[pos++];
+				this->inSysEx = valid && (terminator == 0xF0);
+				if (valid && terminator == 0xF7) {
+					this->sysExBuffer.push_back(0xF7);
+					messages.emplace_back(MidiMessage{ this->sysExBuffer.data(), static_cast<int>(this->sysExBuffer.size()) });
+					count++;
+				}
+				running = 0;
+				continue;
+			}
+
+			//System real time messages are not Mackie Control messages
+			if (status >= 0xF8) {
+				pos++;
+				continue;
+			}
+
+			int commandSize = 0;
+			uint8_t bytes[3] = {};
+			if (status & 0x80) {
+				commandSize = RTPMIDITransport::getCommandSize(status);
+				running = status < 0xF0 ? status : 0;
+				bytes[0] = status;
+				pos++;
+			}
+			else if (running) {
+				commandSize = RTPMIDITransport::getCommandSize(running);
+				bytes[0] = running;
+			}
+			else {
+				//Data byte without status, the rest of the list can not be parsed
+				break;
+			}
+
+			if (pos + commandSize - 1 > size) { break; }
+			for (int i = 1; i < commandSize; i++) {
+				bytes[i] = data[pos++];
+			}
+			messages.emplace_back(MidiMessage{ bytes, commandSize });
+			count++;
+		}
+
+		return count;
+	}
+
+	int RTPMIDITransport::getCommandSize(uint8_t status) {
+		switch (status & 0xF0) {
+		case 0xC0:
+		case 0xD0:
+			return 2;
+		case 0xF0:
+			switch (status) {
+			case 0xF1:
+			case 0xF3:
+				return 2;
+			case 0xF2:
+				return 3;
+			default:
+				return 1;
+			}
+		default:
+			return 3;
+		}
+	}
+}
@@ -0,0 +1,191 @@
+/*****************************************************************//**
+ * \file	RTPMIDITransport.h
+ * \brief	Mackie Control messages over UDP in RTP-MIDI packets.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#import "DatagramSocket.h"
+
+namespace mackieControl {
+	/**
+	 * Send and receive Mackie Control messages over UDP, framed as RTP-MIDI (RFC 6295) packets without recovery
+	 * journal. All messages sent within the batch window are packed into one packet as a MIDI command list with delta
+	 * times and running status. Received packets are checked by their RTP sequence number, so lost packets are counted
+	 * and late or duplicated packets are dropped.
+	 * The session protocol (invitation and clock synchronization) is not part of this class: the peer is set directly.
+	 */
+	class RTPMIDITransport final {
+	public:
+		/**
+		 * Transport parameters.
+		 */
+		struct Config final {
+			/**
+			 * Time to collect messages into one packet (ms). 0 to send each message at once.
+			 */
+			double batchWindowMs = 1;
+			/**
+			 * Maximum size of the MIDI command list of a packet (bytes, up to 4095).
+			 */
+			int maxPayloadSize = 1024;
+			/**
+			 * RTP synchronization source identifier. 0 to choose one at random.
+			 */
+			uint32_t SSRC = 0;
+		};
+
+		/**
+		 * Counters of the transport.
+		 */
+		struct Counters final {
+			uint64_t packetsSent = 0;
+			uint64_t messagesSent = 0;
+			uint64_t bytesSent = 0;
+			uint64_t packetsReceived = 0;
+			uint64_t messagesReceived = 0;
+			uint64_t packetsLost = 0;
+			uint64_t packetsDropped = 0;
+		};
+
+		/**
+		 * RTP clock rate of packet timestamps (Hz).
+		 */
+		static constexpr int ClockRate = 10000;
+		/**
+		 * RTP payload type of the packets.
+		 */
+		static constexpr uint8_t PayloadType = 97;
+
+		/**
+		 * Create a transport with the default parameters.
+		 */
+		RTPMIDITransport();
+		/**
+		 * Create a transport.
+		 * \param config		Transport Parameters
+		 */
+		explicit RTPMIDITransport(const Config& config);
+
+		/**
+		 * Bind the socket to a local port.
+		 * \param localPort		Local Port, or 0 to choose a free one
+		 * \param localAddress	Local Address, or empty for all interfaces
+		 * \return	Whether the socket is bound.
+		 */
+		bool bind(int localPort, const String& localAddress = String{});
+		/**
+		 * Get the local port the socket is bound to.
+		 * \return	Port, or -1 if the socket is not bound.
+		 */
+		int getBoundPort() const;
+		/**
+		 * Set the address of the peer to send to.
+		 * \param host			Peer Address
+		 * \param port			Peer Port
+		 */
+		void setPeer(const String& host, int port);
+
+		/**
+		 * Add a message to the current packet. The packet is sent when the batch window of its first message has
+		 * passed, or when it is full.
+		 * \param message		Message
+		 * \param timeMs		Send Time (ms)
+		 * \return	Whether all packets sent by this call were written.
+		 */
+		bool send(const Message& message, double timeMs);
+		/**
+		 * Add a message to the current packet. System exclusive messages which don't fit in one packet are split into
+		 * segments, each in its own packet.
+		 * \param data			Raw MIDI Data Pointer
+		 * \param size			Raw MIDI Data Size
+		 * \param timeMs		Send Time (ms)
+		 * \return	Whether all packets sent by this call were written.
+		 */
+		bool send(const uint8_t* data, int size, double timeMs);
+		/**
+		 * Send the current packet if its batch window has passed.
+		 * \param timeMs		Current Time (ms)
+		 * \return	Whether the packet was written, or there is nothing to send.
+		 */
+		bool advance(double timeMs);
+		/**
+		 * Send the current packet now.
+		 * \return	Whether the packet was written, or there is nothing to send.
+		 */
+		bool flush();
+		/**
+		 * Get the time the current packet is due.
+		 * \return	Deadline (ms), or a negative value if nothing is pending.
+		 */
+		double getNextDeadline() const;
+
+		/**
+		 * Read all packets available and decode them.
+		 * \param messages		Output Messages
+		 * \param timeoutMs		Time to Wait for the First Packet (ms)
+		 * \return	Number of Messages Decoded
+		 */
+		int receive(std::vector<Message>& messages, int timeoutMs = 0);
+		/**
+		 * Decode a RTP-MIDI packet and append all complete messages. Partial system exclusive messages are kept
+		 * until the following packets complete them.
+		 * \param packet		Packet Pointer
+		 * \param size			Packet Size
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Decoded, or -1 if the packet is malformed or out of order.
+		 */
+		int decode(const uint8_t* packet, int size, std::vector<Message>& messages);
+
+		/**
+		 * Get the counters.
+		 */
+		const Counters& getCounters() const;
+		/**
+		 * Reset the counters.
+		 */
+		void resetCounters();
+		/**
+		 * Drop the current packet and the receive state.
+		 */
+		void reset();
+
+	private:
+		static constexpr int HeaderSize = 12;
+		static constexpr int MaxPacketSize = 65507;
+
+		Config config;
+		DatagramSocket socket;
+		String peerHost;
+		int peerPort = 0;
+		bool bound = false;
+
+		std::vector<uint8_t> commands;
+		std::vector<uint8_t> packet;
+		std::vector<uint8_t> segment;
+		int batchSize = 0;
+		double batchStart = 0, batchLast = 0;
+		uint8_t runningStatus = 0;
+		uint16_t sendSequence = 0;
+
+		std::vector<uint8_t> receiveBuffer;
+		std::vector<uint8_t> sysExBuffer;
+		bool inSysEx = false;
+		bool receiving = false;
+		uint32_t receiveSSRC = 0;
+		uint16_t receiveSequence = 0;
+
+		Counters counters;
+
+		bool addCommand(const uint8_t* data, int size, double timeMs);
+		int decodeCommands(const uint8_t* data, int size, bool firstHasDelta, std::vector<Message>& messages);
+		static int getCommandSize(uint8_t status);
+	};
+}
@@ -0,0 +1,203 @@
+/*****************************************************************//**
+ * \file	SharedSurfaceState.cpp
+ * \brief	Live surface state published in shared memory.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SharedSurfaceState.h"
+#include <chrono>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mackieControl {
+	static_assert(std::is_trivially_copyable_v<SurfaceState>, "SurfaceState must be copyable by memcpy");
+	static_assert(std::atomic<uint32_t>::is_always_lock_free, "Sequence must be lock free to be shared between processes");
+
+	std::unique_ptr<SharedSurfaceState> SharedSurfaceState::create(const std::string& name, int surfaceNum) {
+		if (surfaceNum <= 0) { return nullptr; }
+
+		auto region = std::unique_ptr<SharedSurfaceState>(new SharedSurfaceState);
+		region->name = name;
+		region->owner = true;
+		if (!region->map(true, SharedSurfaceState::getRegionSize(surfaceNum))) { return nullptr; }
+
+		//Sequence 0 is reserved for failure, so slots start at 2
+		for (int i = 0; i < surfaceNum; i++) {
+			auto slot = new (region->getSlot(i)) Slot{};
+			slot->sequence.store(2, std::memory_order_relaxed);
+		}
+
+		auto header = region->getHeader();
+		header->version = Version;
+		header->surfaceNum = static_cast<uint32_t>(surfaceNum);
+		header->stateSize = sizeof(SurfaceState);
+		std::atomic_ref<uint32_t>{ header->magic }.store(Magic, std::memory_order_release);
+
+		return region;
+	}
+
+	std::unique_ptr<SharedSurfaceState> SharedSurfaceState::open(const std::string& name) {
+		auto region = std::unique_ptr<SharedSurfaceState>(new SharedSurfaceState);
+		region->name = name;
+		region->owner = false;
+		if (!region->map(false, 0)) { return nullptr; }
+		if (region->size < sizeof(Header)) { return nullptr; }
+
+		//The magic is written last by the owner, so the rest of the header is only read after it
+		auto header = region->getHeader();
+		if (std::atomic_ref<uint32_t>{ header->magic }.load(std::memory_order_acquire) != Magic) { return nullptr; }
+		if (header->version != Version || header->stateSize != sizeof(SurfaceState)
+			|| region->size < SharedSurfaceState::getRegionSize(static_cast<int>(header->surfaceNum))) {
+			return nullptr;
+		}
+
+		return region;
+	}
+
+	SharedSurfaceState::~SharedSurfaceState() {
+#if defined(_WIN32)
+		if (this->memory) { UnmapViewOfFile(this->memory); }
+		if (this->handle) { CloseHandle(static_cast<HANDLE>(this->handle)); }
+#else
+		if (this->memory) { munmap(this->memory, this->size); }
+		if (this->owner) { shm_unlink(this->name.c_str()); }
+#endif
+	}
+
+	void SharedSurfaceState::publish(int surface, const SurfaceState& state) {
+		if (!this->owner || surface < 0 || surface >= this->getSurfaceNum()) { return; }
+
+		auto slot = this->getSlot(surface);
+		uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+
+		//Odd sequence marks the slot as being written
+		slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(&slot->state, &state, sizeof(SurfaceState));
+		slot->sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	uint32_t SharedSurfaceState::read(int surface, SurfaceState& state, int timeoutMs) const {
+		if (surface < 0 || surface >= this->getSurfaceNum()) { return 0; }
+
+		//An owner which died while writing leaves the sequence odd forever
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{ std::max(timeoutMs, 0) };
+		auto slot = this->getSlot(surface);
+		while (true) {
+			uint32_t before = slot->sequence.load(std::memory_order_acquire);
+			if (before & 1) {
+				if (std::chrono::steady_clock::now() >= deadline) { return 0; }
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::memcpy(&state, &slot->state, sizeof(SurfaceState));
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			uint32_t after = slot->sequence.load(std::memory_order_relaxed);
+			if (before == after) {
+				return before;
+			}
+			if (std::chrono::steady_clock::now() >= deadline) { return 0; }
+		}
+	}
+
+	uint32_t SharedSurfaceState::getSequence(int surface) const {
+		if (surface < 0 || surface >= this->getSurfaceNum()) { return 0; }
+		return this->getSlot(surface)->sequence.load(std::memory_order_acquire);
+	}
+
+	int SharedSurfaceState::getSurfaceNum() const {
+		return static_cast<int>(this->getHeader()->surfaceNum);
+	}
+
+	bool SharedSurfaceState::isOwner() const {
+		return this->owner;
+	}
+
+	SharedSurfaceState::Header* SharedSurfaceState::getHeader() const {
+		return static_cast<Header*>(this->memory);
+	}
+
+	SharedSurfaceState::Slot* SharedSurfaceState::getSlot(int surface) const {
+		auto slots = static_cast<uint8_t*>(this->memory) + sizeof(Slot);
+		return reinterpret_cast<Slot*>(slots) + surface;
+	}
+
+	std::size_t SharedSurfaceState::getRegionSize(int surfaceNum) {
+		//The header takes the place of one slot, so all slots stay aligned
+		static_assert(sizeof(Header) <= sizeof(Slot));
+		return sizeof(Slot) * (static_cast<std::size_t>(surfaceNum) + 1);
+	}
+
+	bool SharedSurfaceState::map(bool create, std::size_t size) {
+#if defined(_WIN32)
+		HANDLE mapping = create
+			? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+				static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), this->name.c_str())
+			: OpenFileMappingA(FILE_MAP_READ, FALSE, this->name.c_str());
+		if (!mapping) { return false; }
+		this->handle = mapping;
+
+		this->memory = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size);
+		if (!this->memory) { return false; }
+
+		if (!create) {
+			MEMORY_BASIC_INFORMATION info{};
+			VirtualQuery(this->memory, &info, sizeof(info));
+			size = info.RegionSize;
+		}
+		this->size = size;
+		return true;
+#else
+		if (!this->name.empty() && this->name.front() != '/') {
+			this->name = "/" + this->name;
+		}
+
+		if (create) {
+			shm_unlink(this->name.c_str());
+		}
+
+		int fd = create
+			? shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644)
+			: shm_open(this->name.c_str(), O_RDONLY, 0);
+		if (fd < 0) { return false; }
+
+		if (create) {
+			if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+				close(fd);
+				return false;
+			}
+		}
+		else {
+			struct stat info {};
+			if (fstat(fd, &info) != 0) {
+				close(fd);
+				return false;
+			}
+			size = static_cast<std::size_t>(info.st_size);
+		}
+
+		void* memory = mmap(nullptr, size, create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED) { return false; }
+
+		this->memory = memory;
+		this->size = size;
+		return true;
+#endif
+	}
+}
@@ -0,0 +1,107 @@
+/*****************************************************************//**
+ * \file	SharedSurfaceState.h
+ * \brief	Live surface state published in shared memory.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "SurfaceState.h"
+#include <atomic>
+#include <string>
+
+namespace mackieControl {
+	/**
+	 * Fixed-layout block of surface states in a named shared memory region.
+	 * One owner process publishes the states, and any number of reader processes take consistent snapshots.
+	 * Each surface slot is guarded by a sequence lock: the writer never waits for readers, and readers retry only
+	 * when they overlap an update. No system call is made per update or per snapshot.
+	 */
+	class SharedSurfaceState final {
+	public:
+		/**
+		 * Create the shared region as its owner. An existing region with the same name is replaced.
+		 * \param name			Region Name
+		 * \param surfaceNum	Number of Surfaces
+		 * \return	The region, or nullptr on failure.
+		 */
+		static std::unique_ptr<SharedSurfaceState> create(const std::string& name, int surfaceNum);
+		/**
+		 * Open an existing shared region as a reader.
+		 * \param name			Region Name
+		 * \return	The region, or nullptr on failure or layout mismatch.
+		 */
+		static std::unique_ptr<SharedSurfaceState> open(const std::string& name);
+
+		/**
+		 * Unmap the region. The owner also removes the name.
+		 */
+		~SharedSurfaceState();
+
+		/**
+		 * Publish the state of a surface. Only the owner may call this, from one thread.
+		 * \param surface		Surface Index
+		 * \param state			Surface State
+		 */
+		void publish(int surface, const SurfaceState& state);
+		/**
+		 * Take a consistent snapshot of a surface.
+		 * \param surface		Surface Index
+		 * \param state			Output Surface State
+		 * \param timeoutMs		Time to keep retrying while the slot is being written (ms)
+		 * \return	Sequence number of the snapshot, which changes on each publish, or 0 on failure or timeout.
+		 */
+		uint32_t read(int surface, SurfaceState& state, int timeoutMs = 100) const;
+		/**
+		 * Get the sequence number of a surface without copying the state.
+		 * Readers can poll this to find out whether a new snapshot is needed.
+		 */
+		uint32_t getSequence(int surface) const;
+
+		/**
+		 * Get the number of surfaces.
+		 */
+		int getSurfaceNum() const;
+		/**
+		 * Check if this is the owner of the region.
+		 */
+		bool isOwner() const;
+
+	private:
+		struct Header final {
+			uint32_t magic;
+			uint32_t version;
+			uint32_t surfaceNum;
+			uint32_t stateSize;
+		};
+
+		struct alignas(64) Slot final {
+			std::atomic<uint32_t> sequence;
+			SurfaceState state;
+		};
+
+		static constexpr uint32_t Magic = 0x4D435353;
+		static constexpr uint32_t Version = 1;
+
+		std::string name;
+		void* handle = nullptr;
+		void* memory = nullptr;
+		std::size_t size = 0;
+		bool owner = false;
+
+		SharedSurfaceState() = default;
+		SharedSurfaceState(const SharedSurfaceState&) = delete;
+		SharedSurfaceState& operator=(const SharedSurfaceState&) = delete;
+
+		Header* getHeader() const;
+		Slot* getSlot(int surface) const;
+
+		static std::size_t getRegionSize(int surfaceNum);
+		bool map(bool create, std::size_t size);
+	};
+}
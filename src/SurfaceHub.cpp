@@ -0,0 +1,130 @@
+/*****************************************************************//**
+ * \file	SurfaceHub.cpp
+ * \brief	Multi-surface hub on a work-stealing thread pool.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceHub.h"
+
+namespace mackieControl {
+	SurfaceHub::SurfaceHub(InputCallback inputCallback, OutputCallback outputCallback, int threadNum)
+		: inputCallback(std::move(inputCallback)), outputCallback(std::move(outputCallback)), executor(threadNum) {}
+
+	SurfaceHub::~SurfaceHub() {
+		this->flush();
+	}
+
+	int SurfaceHub::addDevice() {
+		auto session = std::make_unique<Session>();
+		session->index = static_cast<int>(this->sessions.size());
+		this->sessions.push_back(std::move(session));
+		return static_cast<int>(this->sessions.size()) - 1;
+	}
+
+	int SurfaceHub::getDeviceNum() const {
+		return static_cast<int>(this->sessions.size());
+	}
+
+	void SurfaceHub::postInput(int device, const uint8_t* data, int size) {
+		if (device < 0 || device >= this->getDeviceNum() || size <= 0) { return; }
+
+		auto& session = *(this->sessions[device]);
+		{
+			std::lock_guard lock{ session.mutex };
+			session.inputBytes.insert(session.inputBytes.end(), data, data + size);
+			session.inputSizes.push_back(size);
+		}
+		this->schedule(session);
+	}
+
+	void SurfaceHub::postState(int device, const SurfaceState& state) {
+		if (device < 0 || device >= this->getDeviceNum()) { return; }
+
+		auto& session = *(this->sessions[device]);
+		{
+			std::lock_guard lock{ session.mutex };
+			session.target = state;
+			session.targetChanged = true;
+		}
+		this->schedule(session);
+	}
+
+	void SurfaceHub::postResync(int device) {
+		if (device < 0 || device >= this->getDeviceNum()) { return; }
+
+		auto& session = *(this->sessions[device]);
+		{
+			std::lock_guard lock{ session.mutex };
+			session.resync = true;
+		}
+		this->schedule(session);
+	}
+
+	void SurfaceHub::flush() {
+		this->executor.waitIdle();
+	}
+
+	void SurfaceHub::schedule(Session& session) {
+		//At most one task of a session is queued or running, which keeps the order inside the device
+		if (!session.scheduled.exchange(true)) {
+			this->executor.submit([this, &session] { this->process(session); }, session.index);
+		}
+	}
+
+	void SurfaceHub::process(Session& session) {
+		auto hasWork = [&session] {
+			std::lock_guard lock{ session.mutex };
+			return !session.inputSizes.empty() || session.targetChanged || session.resync;
+		};
+
+		do {
+			SurfaceState target;
+			bool targetChanged = false, resync = false;
+			{
+				std::lock_guard lock{ session.mutex };
+				session.pendingBytes.swap(session.inputBytes);
+				session.pendingSizes.swap(session.inputSizes);
+				if (session.targetChanged) {
+					target = session.target;
+					targetChanged = true;
+					session.targetChanged = false;
+				}
+				resync = session.resync;
+				session.resync = false;
+			}
+
+			//Input decoding
+			int offset = 0;
+			for (int size : session.pendingSizes) {
+				Message message{ MidiMessage{ &session.pendingBytes[offset], size } };
+				if (message.isMackieControl()) {
+					this->inputCallback(session.index, message);
+				}
+				offset += size;
+			}
+			session.pendingBytes.clear();
+			session.pendingSizes.clear();
+
+			//State diffing and output encoding
+			session.output.clear();
+			if (resync) {
+				if (targetChanged) { session.sent = target; }
+				SurfaceResync::create(session.sent, session.output);
+			}
+			else if (targetChanged) {
+				SurfaceResync::createDiff(session.sent, target, session.output);
+				session.sent = target;
+			}
+			for (auto& message : session.output) {
+				this->outputCallback(session.index, message);
+			}
+
+			session.scheduled.store(false);
+		} while (hasWork() && !session.scheduled.exchange(true));
+	}
+}
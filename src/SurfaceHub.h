@@ -0,0 +1,107 @@
+/*****************************************************************//**
+ * \file	SurfaceHub.h
+ * \brief	Multi-surface hub on a work-stealing thread pool.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "SurfaceResync.h"
+#include "WorkStealingExecutor.h"
+
+namespace mackieControl {
+	/**
+	 * Hub of many Mackie Control device sessions.
+	 * Each session decodes input from its device, diffs the target surface state against what the device shows, and
+	 * encodes output for it. Work of one session runs on one worker at a time, so the order inside a device is kept,
+	 * while different devices progress in parallel.
+	 * Callbacks are called on worker threads.
+	 */
+	class SurfaceHub final {
+	public:
+		/**
+		 * Called for each valid Mackie Control message received from a device.
+		 */
+		using InputCallback = std::function<void(int device, const Message& message)>;
+		/**
+		 * Called for each message to send to a device.
+		 */
+		using OutputCallback = std::function<void(int device, const Message& message)>;
+
+		/**
+		 * Create a hub.
+		 * \param inputCallback		Input Callback
+		 * \param outputCallback	Output Callback
+		 * \param threadNum			Number of Workers (0 for hardware concurrency)
+		 */
+		SurfaceHub(InputCallback inputCallback, OutputCallback outputCallback, int threadNum = 0);
+		/**
+		 * Finish all queued work.
+		 */
+		~SurfaceHub();
+
+		/**
+		 * Add a device session. Add all devices before posting any work.
+		 * \return	Device Index
+		 */
+		int addDevice();
+		/**
+		 * Get the number of device sessions.
+		 */
+		int getDeviceNum() const;
+
+		/**
+		 * Queue raw MIDI data received from a device.
+		 * \param device		Device Index
+		 * \param data			Raw MIDI Data Pointer
+		 * \param size			Raw MIDI Data Size
+		 */
+		void postInput(int device, const uint8_t* data, int size);
+		/**
+		 * Set the state the device should show. Only the difference to the last sent state is encoded.
+		 * \param device		Device Index
+		 * \param state			Target Surface State
+		 */
+		void postState(int device, const SurfaceState& state);
+		/**
+		 * Send the whole state to the device again, such as after reconnecting.
+		 * \param device		Device Index
+		 */
+		void postResync(int device);
+
+		/**
+		 * Block until all queued work is finished.
+		 */
+		void flush();
+
+	private:
+		struct Session final {
+			int index = 0;
+			std::mutex mutex;
+			std::vector<uint8_t> inputBytes;
+			std::vector<int> inputSizes;
+			SurfaceState target;
+			bool targetChanged = false;
+			bool resync = false;
+			std::atomic<bool> scheduled = false;
+
+			SurfaceState sent;
+			std::vector<uint8_t> pendingBytes;
+			std::vector<int> pendingSizes;
+			std::vector<Message> output;
+		};
+
+		InputCallback inputCallback;
+		OutputCallback outputCallback;
+		std::vector<std::unique_ptr<Session>> sessions;
+		WorkStealingExecutor executor;
+
+		void schedule(Session& session);
+		void process(Session& session);
+	};
+}
@@ -0,0 +1,367 @@
+/*****************************************************************//**
+ * \file	SurfaceMirror.cpp
+ * \brief	Delta-compressed mirroring of surface state to remote clients.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceMirror.h"
+#include "SurfaceResync.h"
+#include <cstring>
+
+namespace mackieControl {
+	constexpr uint8_t Keyframe = 0;
+	constexpr uint8_t Delta = 1;
+
+	constexpr uint8_t LEDSection = 0x01;
+	constexpr uint8_t FaderSection = 0x02;
+	constexpr uint8_t RingSection = 0x04;
+	constexpr uint8_t LCDSection = 0x08;
+	constexpr uint8_t TimeCodeSection = 0x10;
+	constexpr uint8_t AssignmentSection = 0x20;
+	constexpr uint8_t MeterSection = 0x40;
+
+	constexpr int LEDGroupSize = 8;
+	constexpr int LEDGroupNum = 128 / LEDGroupSize;
+	constexpr int HeaderSize = 4;
+
+	static uint8_t toLEDCode(VelocityMessage vel) {
+		return (vel == VelocityMessage::Off) ? 0 : ((vel == VelocityMessage::Flashing) ? 1 : 2);
+	}
+
+	static VelocityMessage fromLEDCode(int code) {
+		return (code == 0) ? VelocityMessage::Off : ((code == 1) ? VelocityMessage::Flashing : VelocityMessage::On);
+	}
+
+	static void writeWord(std::vector<uint8_t>& frame, uint16_t value) {
+		frame.push_back(static_cast<uint8_t>(value & 0xFF));
+		frame.push_back(static_cast<uint8_t>(value >> 8));
+	}
+
+	/**
+	 * Write the parts of a state which differ from another state, or all parts if there is no other state.
+	 * Return the section mask.
+	 */
+	static uint8_t writeSections(const SurfaceState* from, const SurfaceState& to, std::vector<uint8_t>& frame) {
+		uint8_t sections = 0;
+
+		{
+			uint16_t mask = 0;
+			for (int i = 0; i < LEDGroupNum; i++) {
+				bool changed = !from || std::memcmp(&from->LEDs[i * LEDGroupSize], &to.LEDs[i * LEDGroupSize],
+					LEDGroupSize * sizeof(VelocityMessage)) != 0;
+				mask |= changed ? (1 << i) : 0;
+			}
+			if (mask) {
+				sections |= LEDSection;
+				writeWord(frame, mask);
+				for (int i = 0; i < LEDGroupNum; i++) {
+					if (!((mask >> i) & 1)) { continue; }
+
+					uint16_t bits = 0;
+					for (int j = 0; j < LEDGroupSize; j++) {
+						bits |= toLEDCode(to.LEDs[i * LEDGroupSize + j]) << (j * 2);
+					}
+					writeWord(frame, bits);
+				}
+			}
+		}
+
+		{
+			uint16_t mask = 0;
+			for (int i = 0; i < SurfaceState::FaderNum; i++) {
+				mask |= (!from || from->faders[i] != to.faders[i]) ? (1 << i) : 0;
+			}
+			if (mask) {
+				sections |= FaderSection;
+				writeWord(frame, mask);
+				for (int i = 0; i < SurfaceState::FaderNum; i++) {
+					if ((mask >> i) & 1) { writeWord(frame, to.faders[i]); }
+				}
+			}
+		}
+
+		{
+			uint8_t mask = 0;
+			for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+				mask |= (!from || from->vPotLEDRings[i] != to.vPotLEDRings[i]) ? (1 << i) : 0;
+			}
+			if (mask) {
+				sections |= RingSection;
+				frame.push_back(mask);
+				for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+					if ((mask >> i) & 1) { frame.push_back(to.vPotLEDRings[i]); }
+				}
+			}
+		}
+
+		{
+			//Runs closer than the run header are merged
+			constexpr int LCDMergeGap = 2;
+			std::size_t countPos = frame.size();
+			frame.push_back(0);
+
+			int runNum = 0;
+			int size = static_cast<int>(to.LCD.size());
+			for (int i = 0; i < size;) {
+				if (from && from->LCD[i] == to.LCD[i]) { i++; continue; }
+
+				int start = i, end = i + 1;
+				for (int j = end; j < size && j - end <= LCDMergeGap; j++) {
+					if (!from || from->LCD[j] != to.LCD[j]) { end = j + 1; }
+				}
+
+				frame.push_back(static_cast<uint8_t>(start));
+				frame.push_back(static_cast<uint8_t>(end - start));
+				frame.insert(frame.end(), &to.LCD[start], &to.LCD[start] + (end - start));
+				runNum++;
+				i = end;
+			}
+
+			if (runNum > 0) {
+				sections |= LCDSection;
+				frame[countPos] = static_cast<uint8_t>(runNum);
+			}
+			else {
+				frame.pop_back();
+			}
+		}
+
+		{
+			uint16_t mask = 0;
+			for (int i = 0; i < static_cast<int>(to.timeCodeBBTDisplay.size()); i++) {
+				mask |= (!from || from->timeCodeBBTDisplay[i] != to.timeCodeBBTDisplay[i]) ? (1 << i) : 0;
+			}
+			if (mask) {
+				sections |= TimeCodeSection;
+				writeWord(frame, mask);
+				for (int i = 0; i < static_cast<int>(to.timeCodeBBTDisplay.size()); i++) {
+					if ((mask >> i) & 1) { frame.push_back(to.timeCodeBBTDisplay[i]); }
+				}
+			}
+		}
+
+		if (!from || from->assignment7SegmentDisplay != to.assignment7SegmentDisplay) {
+			sections |= AssignmentSection;
+			frame.insert(frame.end(), to.assignment7SegmentDisplay.begin(), to.assignment7SegmentDisplay.end());
+		}
+
+		{
+			uint8_t mask = 0;
+			for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+				mask |= (!from || from->meters[i] != to.meters[i]) ? (1 << i) : 0;
+			}
+			if (mask || !from || from->meterOverload != to.meterOverload) {
+				sections |= MeterSection;
+				frame.push_back(mask);
+
+				//Meter values (0-12) are packed two per byte
+				int count = 0;
+				for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+					if (!((mask >> i) & 1)) { continue; }
+					if (count & 1) { frame.back() |= static_cast<uint8_t>(to.meters[i] << 4); }
+					else { frame.push_back(to.meters[i] & 0x0F); }
+					count++;
+				}
+				frame.push_back(to.meterOverload);
+			}
+		}
+
+		return sections;
+	}
+
+	/**
+	 * Bounds checked reader of a frame.
+	 */
+	struct FrameReader final {
+		const uint8_t* data;
+		std::size_t size;
+		std::size_t pos = 0;
+		bool failed = false;
+
+		uint8_t readByte() {
+			if (this->pos >= this->size) {
+				this->failed = true;
+				return 0;
+			}
+			return this->data[this->pos++];
+		}
+
+		uint16_t readWord() {
+			uint16_t low = this->readByte();
+			return static_cast<uint16_t>(low | (this->readByte() << 8));
+		}
+	};
+
+	static bool readSections(FrameReader& reader, uint8_t sections, SurfaceState& state) {
+		if (sections & LEDSection) {
+			uint16_t mask = reader.readWord();
+			for (int i = 0; i < LEDGroupNum; i++) {
+				if (!((mask >> i) & 1)) { continue; }
+
+				uint16_t bits = reader.readWord();
+				for (int j = 0; j < LEDGroupSize; j++) {
+					state.LEDs[i * LEDGroupSize + j] = fromLEDCode((bits >> (j * 2)) & 3);
+				}
+			}
+		}
+
+		if (sections & FaderSection) {
+			uint16_t mask = reader.readWord();
+			for (int i = 0; i < SurfaceState::FaderNum; i++) {
+				if ((mask >> i) & 1) { state.faders[i] = reader.readWord() & 0x3FFF; }
+			}
+		}
+
+		if (sections & RingSection) {
+			uint8_t mask = reader.readByte();
+			for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+				if ((mask >> i) & 1) { state.vPotLEDRings[i] = reader.readByte(); }
+			}
+		}
+
+		if (sections & LCDSection) {
+			int runNum = reader.readByte();
+			for (int i = 0; i < runNum && !reader.failed; i++) {
+				int start = reader.readByte();
+				int size = reader.readByte();
+				if (start + size > static_cast<int>(state.LCD.size())) { return false; }
+				for (int j = 0; j < size; j++) {
+					state.LCD[start + j] = static_cast<char>(reader.readByte());
+				}
+			}
+		}
+
+		if (sections & TimeCodeSection) {
+			uint16_t mask = reader.readWord();
+			for (int i = 0; i < static_cast<int>(state.timeCodeBBTDisplay.size()); i++) {
+				if ((mask >> i) & 1) { state.timeCodeBBTDisplay[i] = reader.readByte(); }
+			}
+		}
+
+		if (sections & AssignmentSection) {
+			for (auto& c : state.assignment7SegmentDisplay) {
+				c = reader.readByte();
+			}
+		}
+
+		if (sections & MeterSection) {
+			uint8_t mask = reader.readByte();
+			int count = 0;
+			uint8_t packed = 0;
+			for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+				if (!((mask >> i) & 1)) { continue; }
+				if (!(count & 1)) { packed = reader.readByte(); }
+				state.meters[i] = (count & 1) ? (packed >> 4) : (packed & 0x0F);
+				count++;
+			}
+			state.meterOverload = reader.readByte();
+		}
+
+		return !reader.failed && reader.pos == reader.size;
+	}
+
+	SurfaceMirrorEncoder::SurfaceMirrorEncoder(int keyframeInterval)
+		: keyframeInterval(std::max(keyframeInterval, 1)) {}
+
+	int SurfaceMirrorEncoder::encode(const SurfaceState& state, std::vector<uint8_t>& frame) {
+		if (++this->framesSinceKeyframe >= this->keyframeInterval) {
+			this->keyframeDue = true;
+		}
+
+		//Header: type, sequence, section mask
+		std::size_t start = frame.size();
+		frame.push_back(this->keyframeDue ? Keyframe : Delta);
+		writeWord(frame, this->sequence);
+		frame.push_back(0);
+
+		uint8_t sections = writeSections(this->keyframeDue ? nullptr : &(this->last), state, frame);
+		if (sections == 0) {
+			frame.resize(start);
+			return 0;
+		}
+		frame[start + HeaderSize - 1] = sections;
+
+		if (this->keyframeDue) {
+			this->keyframeDue = false;
+			this->framesSinceKeyframe = 0;
+			this->counters.keyframes++;
+		}
+		else {
+			this->counters.deltas++;
+		}
+
+		this->last = state;
+		this->sequence++;
+
+		int size = static_cast<int>(frame.size() - start);
+		this->counters.bytes += size;
+		return size;
+	}
+
+	void SurfaceMirrorEncoder::requestKeyframe() {
+		this->keyframeDue = true;
+	}
+
+	SurfaceMirrorEncoder::Counters SurfaceMirrorEncoder::getCounters() const {
+		return this->counters;
+	}
+
+	bool SurfaceMirrorDecoder::decode(const uint8_t* data, std::size_t size) {
+		if (!data || size < HeaderSize) { return false; }
+
+		FrameReader reader{ data, size };
+		uint8_t type = reader.readByte();
+		uint16_t sequence = reader.readWord();
+		uint8_t sections = reader.readByte();
+
+		//A delta frame only applies on top of the frame just before it
+		SurfaceState next;
+		if (type == Delta) {
+			if (!this->synced || sequence != static_cast<uint16_t>(this->sequence + 1)) {
+				this->synced = false;
+				return false;
+			}
+			next = this->state;
+		}
+		else if (type != Keyframe) {
+			return false;
+		}
+
+		if (!readSections(reader, sections, next)) {
+			this->synced = false;
+			return false;
+		}
+
+		this->state = next;
+		this->sequence = sequence;
+		this->synced = true;
+		return true;
+	}
+
+	bool SurfaceMirrorDecoder::decode(const uint8_t* data, std::size_t size, std::vector<Message>& messages) {
+		bool wasSynced = this->synced;
+		SurfaceState previous = this->state;
+		if (!this->decode(data, size)) { return false; }
+
+		if (wasSynced) {
+			SurfaceResync::createDiff(previous, this->state, messages);
+		}
+		else {
+			SurfaceResync::create(this->state, messages);
+		}
+		return true;
+	}
+
+	const SurfaceState& SurfaceMirrorDecoder::getState() const {
+		return this->state;
+	}
+
+	bool SurfaceMirrorDecoder::isSynced() const {
+		return this->synced;
+	}
+}
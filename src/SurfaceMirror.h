@@ -0,0 +1,106 @@
+/*****************************************************************//**
+ * \file	SurfaceMirror.h
+ * \brief	Delta-compressed mirroring of surface state to remote clients.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "SurfaceState.h"
+
+namespace mackieControl {
+	/**
+	 * Encode the state of a surface into mirroring frames.
+	 * A keyframe holds the whole state, so a client can join at any keyframe. A delta frame holds only the parts which
+	 * changed since the last frame, bit-packed: 2-bit LED states in groups of 8, 14-bit fader words, ring values,
+	 * LCD byte ranges, display characters and meter nibbles, each part behind a change mask.
+	 * Every frame starts with a type byte and a 16-bit sequence number, so a client can detect lost frames.
+	 */
+	class SurfaceMirrorEncoder final {
+	public:
+		/**
+		 * Counters of the encoder.
+		 */
+		struct Counters final {
+			uint64_t keyframes = 0;
+			uint64_t deltas = 0;
+			uint64_t bytes = 0;
+		};
+
+		/**
+		 * Create an encoder. The first frame is a keyframe.
+		 * \param keyframeInterval	Number of Encode Calls between Keyframes
+		 */
+		explicit SurfaceMirrorEncoder(int keyframeInterval = 100);
+
+		/**
+		 * Encode the next frame of the state.
+		 * \param state			Surface State
+		 * \param frame			Output Frame, the frame is appended
+		 * \return	Size of the frame, or 0 if nothing changed and no keyframe is due.
+		 */
+		int encode(const SurfaceState& state, std::vector<uint8_t>& frame);
+
+		/**
+		 * Make the next frame a keyframe, such as when a client joins or reports a lost frame.
+		 */
+		void requestKeyframe();
+
+		/**
+		 * Get the counters.
+		 */
+		Counters getCounters() const;
+
+	private:
+		SurfaceState last;
+		int keyframeInterval;
+		int framesSinceKeyframe = 0;
+		bool keyframeDue = true;
+		uint16_t sequence = 0;
+		Counters counters;
+	};
+
+	/**
+	 * Rebuild the state of a surface from mirroring frames.
+	 * The decoder is synced after a keyframe. A lost or malformed frame unsyncs it until the next keyframe, so the
+	 * client never shows a state which differs from the source.
+	 */
+	class SurfaceMirrorDecoder final {
+	public:
+		/**
+		 * Decode a frame.
+		 * \param data			Frame Data
+		 * \param size			Frame Size
+		 * \return	Whether the frame was applied.
+		 */
+		bool decode(const uint8_t* data, std::size_t size);
+		/**
+		 * Decode a frame, and append the messages which bring a surface showing the last state to the new state.
+		 * The whole resync sequence is appended for the first keyframe after being unsynced.
+		 * \param data			Frame Data
+		 * \param size			Frame Size
+		 * \param messages		Output Messages
+		 * \return	Whether the frame was applied.
+		 */
+		bool decode(const uint8_t* data, std::size_t size, std::vector<Message>& messages);
+
+		/**
+		 * Get the decoded state.
+		 */
+		const SurfaceState& getState() const;
+		/**
+		 * Check if the decoder is synced. A keyframe should be requested if not.
+		 */
+		bool isSynced() const;
+
+	private:
+		SurfaceState state;
+		bool synced = false;
+		uint16_t sequence = 0;
+	};
+}
@@ -0,0 +1,145 @@
+/*****************************************************************//**
+ * \file	SurfaceResync.cpp
+ * \brief	Full state resync of a Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceResync.h"
+
+namespace mackieControl {
+	void SurfaceResync::create(const SurfaceState& state, std::vector<Message>& messages) {
+		for (int i = 0; i < SurfaceState::FaderNum; i++) {
+			messages.emplace_back(Message::createPitchWheel(i + 1, state.faders[i]));
+		}
+
+		messages.emplace_back(Message::createAllLEDsOff());
+		for (int i = 0; i < static_cast<int>(state.LEDs.size()); i++) {
+			if (state.LEDs[i] != VelocityMessage::Off && isValidNoteMessage(i)) {
+				messages.emplace_back(Message::createNote(static_cast<NoteMessage>(i), state.LEDs[i]));
+			}
+		}
+
+		for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+			messages.emplace_back(Message::createCC(
+				static_cast<CCMessage>(static_cast<int>(CCMessage::VPotLEDRing1) + i), state.vPotLEDRings[i]));
+		}
+
+		//Two controller messages are shorter than one system exclusive message
+		messages.emplace_back(Message::createCC(
+			CCMessage::Assignment7SegmentDisplay1, state.assignment7SegmentDisplay[0]));
+		messages.emplace_back(Message::createCC(
+			CCMessage::Assignment7SegmentDisplay2, state.assignment7SegmentDisplay[1]));
+
+		messages.emplace_back(Message::createLCD(
+			Message::toLCDPlace(false, 0), &state.LCD[0], SurfaceState::LCDLineSize));
+		messages.emplace_back(Message::createLCD(
+			Message::toLCDPlace(true, 0), &state.LCD[SurfaceState::LCDLineSize], SurfaceState::LCDLineSize));
+
+		//One system exclusive message is shorter than ten controller messages
+		messages.emplace_back(Message::createTimeCodeBBTDisplay(
+			state.timeCodeBBTDisplay.data(), static_cast<int>(state.timeCodeBBTDisplay.size())));
+	}
+
+	std::vector<Message> SurfaceResync::create(const SurfaceState& state) {
+		std::vector<Message> messages;
+		messages.reserve(SurfaceState::FaderNum + 1 + 128 + SurfaceState::ChannelNum + 2 + 2 + 1);
+		SurfaceResync::create(state, messages);
+		return messages;
+	}
+
+	int SurfaceResync::createDiff(const SurfaceState& from, const SurfaceState& to, std::vector<Message>& messages) {
+		auto oldSize = messages.size();
+
+		for (int i = 0; i < SurfaceState::FaderNum; i++) {
+			if (from.faders[i] != to.faders[i]) {
+				messages.emplace_back(Message::createPitchWheel(i + 1, to.faders[i]));
+			}
+		}
+
+		for (int i = 0; i < static_cast<int>(to.LEDs.size()); i++) {
+			if (from.LEDs[i] != to.LEDs[i] && isValidNoteMessage(i)) {
+				messages.emplace_back(Message::createNote(static_cast<NoteMessage>(i), to.LEDs[i]));
+			}
+		}
+
+		for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+			if (from.vPotLEDRings[i] != to.vPotLEDRings[i]) {
+				messages.emplace_back(Message::createCC(
+					static_cast<CCMessage>(static_cast<int>(CCMessage::VPotLEDRing1) + i), to.vPotLEDRings[i]));
+			}
+		}
+
+		for (int i = 0; i < SurfaceState::ChannelNum; i++) {
+			bool overloadChanged = ((from.meterOverload ^ to.meterOverload) >> i) & 1;
+			if (from.meters[i] != to.meters[i]) {
+				messages.emplace_back(Message::createChannelPressure(i + 1, to.meters[i]));
+			}
+			if (overloadChanged) {
+				messages.emplace_back(Message::createChannelPressure(i + 1, ((to.meterOverload >> i) & 1) ? 14 : 15));
+			}
+		}
+
+		for (int i = 0; i < static_cast<int>(to.assignment7SegmentDisplay.size()); i++) {
+			if (from.assignment7SegmentDisplay[i] != to.assignment7SegmentDisplay[i]) {
+				messages.emplace_back(Message::createCC(
+					static_cast<CCMessage>(static_cast<int>(CCMessage::Assignment7SegmentDisplay1) + i),
+					to.assignment7SegmentDisplay[i]));
+			}
+		}
+
+		//Runs of changed characters closer than the system exclusive overhead are merged
+		constexpr int LCDMergeGap = 8;
+		for (int line = 0; line < 2; line++) {
+			int base = line * SurfaceState::LCDLineSize;
+			int start = -1, end = -1;
+			for (int i = 0; i < SurfaceState::LCDLineSize; i++) {
+				if (from.LCD[base + i] != to.LCD[base + i]) {
+					if (start >= 0 && i - end > LCDMergeGap) {
+						messages.emplace_back(Message::createLCD(
+							Message::toLCDPlace(line == 1, static_cast<uint8_t>(start)), &to.LCD[base + start], end - start));
+						start = -1;
+					}
+					if (start < 0) { start = i; }
+					end = i + 1;
+				}
+			}
+			if (start >= 0) {
+				messages.emplace_back(Message::createLCD(
+					Message::toLCDPlace(line == 1, static_cast<uint8_t>(start)), &to.LCD[base + start], end - start));
+			}
+		}
+
+		//Single digits are sent as controller messages, more than a few as one system exclusive message
+		int timeCodeChanged = 0;
+		for (int i = 0; i < static_cast<int>(to.timeCodeBBTDisplay.size()); i++) {
+			timeCodeChanged += (from.timeCodeBBTDisplay[i] != to.timeCodeBBTDisplay[i]) ? 1 : 0;
+		}
+		if (timeCodeChanged * 3 >= 19) {
+			messages.emplace_back(Message::createTimeCodeBBTDisplay(
+				to.timeCodeBBTDisplay.data(), static_cast<int>(to.timeCodeBBTDisplay.size())));
+		}
+		else {
+			for (int i = 0; i < static_cast<int>(to.timeCodeBBTDisplay.size()); i++) {
+				if (from.timeCodeBBTDisplay[i] != to.timeCodeBBTDisplay[i]) {
+					messages.emplace_back(Message::createCC(
+						static_cast<CCMessage>(static_cast<int>(CCMessage::TimeCodeBBTDisplay10) - i), to.timeCodeBBTDisplay[i]));
+				}
+			}
+		}
+
+		return static_cast<int>(messages.size() - oldSize);
+	}
+
+	int SurfaceResync::getByteSize(const std::vector<Message>& messages) {
+		int size = 0;
+		for (auto& message : messages) {
+			size += message.getRawDataSize();
+		}
+		return size;
+	}
+}
@@ -0,0 +1,58 @@
+/*****************************************************************//**
+ * \file	SurfaceResync.h
+ * \brief	Full state resync of a Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "SurfaceState.h"
+
+namespace mackieControl {
+	/**
+	 * Create the message sequence which repaints a whole surface after reconnecting or power cycling.
+	 * The sequence uses the fewest bytes for each part of the state, and is ordered so that the surface looks
+	 * correct as early as possible:
+	 * 1. Faders, so the motors settle while the rest is streaming.
+	 * 2. All LEDs Off, followed only by the LEDs which are on or flashing.
+	 * 3. V-Pot LED rings and the assignment display.
+	 * 4. LCD, one message per line.
+	 * 5. Time Code/BBT display, in one message.
+	 */
+	class SurfaceResync final {
+	public:
+		SurfaceResync() = delete;
+
+		/**
+		 * Append the resync messages of the state.
+		 * \param state			Surface State
+		 * \param messages		Output Messages
+		 */
+		static void create(const SurfaceState& state, std::vector<Message>& messages);
+		/**
+		 * Create the resync messages of the state.
+		 * \param state			Surface State
+		 */
+		static std::vector<Message> create(const SurfaceState& state);
+
+		/**
+		 * Append the messages which change the surface from one state to another.
+		 * Only changed parts are sent; LCD changes are sent as one message per run of changed characters.
+		 * \param from			Current Surface State
+		 * \param to			Target Surface State
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Appended
+		 */
+		static int createDiff(const SurfaceState& from, const SurfaceState& to, std::vector<Message>& messages);
+
+		/**
+		 * Get the number of MIDI bytes of the messages.
+		 */
+		static int getByteSize(const std::vector<Message>& messages);
+	};
+}
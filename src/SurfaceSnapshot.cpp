@@ -0,0 +1,249 @@
+/*****************************************************************//**
+ * \file	SurfaceSnapshot.cpp
+ * \brief	Persisted surface state for instant startup.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceSnapshot.h"
+#include "SurfaceResync.h"
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+namespace mackieControl {
+	static_assert(std::is_trivially_copyable_v<SurfaceState>, "SurfaceState must be copyable by memcpy");
+
+	bool SurfaceSnapshot::save(const std::string& path, const std::vector<SurfaceState>& states, const Bank& bank) {
+		if (path.empty() || states.empty()) { return false; }
+
+		Header header{};
+		header.magic = Magic;
+		header.version = Version;
+		header.headerSize = sizeof(Header);
+		header.stateSize = sizeof(SurfaceState);
+		header.surfaceNum = static_cast<uint32_t>(states.size());
+		header.bank = bank;
+		header.checksum = SurfaceSnapshot::getContentChecksum(header, states.data());
+
+		//Write beside the old file, then swap it in, so readers see the old or the new snapshot and nothing between
+		std::string temp = path + ".tmp";
+		if (!SurfaceSnapshot::write(temp, header, states)) { return false; }
+
+#if defined(_WIN32)
+		if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+			DeleteFileA(temp.c_str());
+			return false;
+		}
+#else
+		if (std::rename(temp.c_str(), path.c_str()) != 0) {
+			unlink(temp.c_str());
+			return false;
+		}
+#endif
+		return true;
+	}
+
+	std::unique_ptr<SurfaceSnapshot> SurfaceSnapshot::load(const std::string& path) {
+		auto snapshot = std::unique_ptr<SurfaceSnapshot>(new SurfaceSnapshot);
+		if (!snapshot->map(path)) { return nullptr; }
+		if (snapshot->size < sizeof(Header)) { return nullptr; }
+
+		auto header = snapshot->getHeader();
+		if (header->magic != Magic || header->version != Version
+			|| header->headerSize != sizeof(Header) || header->stateSize != sizeof(SurfaceState)
+			|| header->surfaceNum == 0
+			|| snapshot->size < SurfaceSnapshot::getFileSize(static_cast<int>(header->surfaceNum))) {
+			return nullptr;
+		}
+		if (header->checksum != SurfaceSnapshot::getContentChecksum(*header, snapshot->getStates())) {
+			return nullptr;
+		}
+
+		return snapshot;
+	}
+
+	SurfaceSnapshot::~SurfaceSnapshot() {
+#if defined(_WIN32)
+		if (this->memory) { UnmapViewOfFile(this->memory); }
+		if (this->handle) { CloseHandle(static_cast<HANDLE>(this->handle)); }
+#else
+		if (this->memory) { munmap(this->memory, this->size); }
+#endif
+	}
+
+	int SurfaceSnapshot::getSurfaceNum() const {
+		return static_cast<int>(this->getHeader()->surfaceNum);
+	}
+
+	const SurfaceState* SurfaceSnapshot::getState(int surface) const {
+		if (surface < 0 || surface >= this->getSurfaceNum()) { return nullptr; }
+		return this->getStates() + surface;
+	}
+
+	SurfaceSnapshot::Bank SurfaceSnapshot::getBank() const {
+		return this->getHeader()->bank;
+	}
+
+	int SurfaceSnapshot::repaint(int surface, std::vector<Message>& messages) const {
+		auto state = this->getState(surface);
+		if (!state) { return 0; }
+
+		std::size_t before = messages.size();
+		SurfaceResync::create(*state, messages);
+		return static_cast<int>(messages.size() - before);
+	}
+
+	int SurfaceSnapshot::repaint(int surface, const SurfaceState& current, std::vector<Message>& messages) const {
+		auto state = this->getState(surface);
+		if (!state) { return 0; }
+
+		return SurfaceResync::createDiff(current, *state, messages);
+	}
+
+	uint32_t SurfaceSnapshot::getChecksum(const void* data, std::size_t size, uint32_t hash) {
+		auto ptr = static_cast<const uint8_t*>(data);
+		for (std::size_t i = 0; i < size; i++) {
+			hash = (hash ^ ptr[i]) * 16777619u;
+		}
+		return hash;
+	}
+
+	const SurfaceSnapshot::Header* SurfaceSnapshot::getHeader() const {
+		return static_cast<const Header*>(this->memory);
+	}
+
+	const SurfaceState* SurfaceSnapshot::getStates() const {
+		auto states = static_cast<const uint8_t*>(this->memory) + sizeof(Header);
+		return reinterpret_cast<const SurfaceState*>(states);
+	}
+
+	std::size_t SurfaceSnapshot::getFileSize(int surfaceNum) {
+		return sizeof(Header) + sizeof(SurfaceState) * static_cast<std::size_t>(surfaceNum);
+	}
+
+	uint32_t SurfaceSnapshot::getContentChecksum(const Header& header, const SurfaceState* states) {
+		uint32_t hash = SurfaceSnapshot::getChecksum(&header.bank, sizeof(Bank));
+		return SurfaceSnapshot::getChecksum(states, sizeof(SurfaceState) * header.surfaceNum, hash);
+	}
+
+	bool SurfaceSnapshot::write(const std::string& path, const Header& header, const std::vector<SurfaceState>& states) {
+		std::size_t size = SurfaceSnapshot::getFileSize(static_cast<int>(states.size()));
+
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+			CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) { return false; }
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+		if (!mapping) {
+			CloseHandle(file);
+			DeleteFileA(path.c_str());
+			return false;
+		}
+
+		void* memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+		if (!memory) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			DeleteFileA(path.c_str());
+			return false;
+		}
+
+		std::memcpy(memory, &header, sizeof(Header));
+		std::memcpy(static_cast<uint8_t*>(memory) + sizeof(Header), states.data(), sizeof(SurfaceState) * states.size());
+
+		bool result = FlushViewOfFile(memory, size) != FALSE;
+		UnmapViewOfFile(memory);
+		CloseHandle(mapping);
+		result = (FlushFileBuffers(file) != FALSE) && result;
+		CloseHandle(file);
+		if (!result) { DeleteFileA(path.c_str()); }
+		return result;
+#else
+		int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+		if (fd < 0) { return false; }
+
+		if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+			close(fd);
+			unlink(path.c_str());
+			return false;
+		}
+
+		void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (memory == MAP_FAILED) {
+			close(fd);
+			unlink(path.c_str());
+			return false;
+		}
+
+		std::memcpy(memory, &header, sizeof(Header));
+		std::memcpy(static_cast<uint8_t*>(memory) + sizeof(Header), states.data(), sizeof(SurfaceState) * states.size());
+
+		//The data must be on disk before the rename makes it visible
+		bool result = msync(memory, size, MS_SYNC) == 0;
+		munmap(memory, size);
+		close(fd);
+		if (!result) { unlink(path.c_str()); }
+		return result;
+#endif
+	}
+
+	bool SurfaceSnapshot::map(const std::string& path) {
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) { return false; }
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		//The mapping keeps the file open
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping) { return false; }
+		this->handle = mapping;
+
+		this->memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!this->memory) { return false; }
+
+		this->size = static_cast<std::size_t>(size.QuadPart);
+		return true;
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) { return false; }
+
+		struct stat info {};
+		if (fstat(fd, &info) != 0 || info.st_size == 0) {
+			close(fd);
+			return false;
+		}
+		std::size_t size = static_cast<std::size_t>(info.st_size);
+
+		//A private mapping is not affected by the next save, which replaces the file instead of writing into it
+		void* memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED) { return false; }
+
+		this->memory = memory;
+		this->size = size;
+		return true;
+#endif
+	}
+}
@@ -0,0 +1,130 @@
+/*****************************************************************//**
+ * \file	SurfaceSnapshot.h
+ * \brief	Persisted surface state for instant startup.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "SurfaceState.h"
+#include <string>
+
+namespace mackieControl {
+	/**
+	 * Versioned binary snapshot file of the states of all surfaces and the bank position.
+	 * The file is a header followed by the raw SurfaceState array. Saving writes a temporary file through a mapping and
+	 * renames it over the old snapshot, so a crash never leaves a torn file. Loading maps the file and validates the
+	 * header and checksum, then the states are used in place without parsing.
+	 * The layout is native to the machine; a snapshot written on a different layout is rejected.
+	 */
+	class SurfaceSnapshot final {
+	public:
+		/**
+		 * Bank position of the surfaces.
+		 */
+		struct Bank final {
+			/**
+			 * Index of the track on the first strip of the first surface.
+			 */
+			int32_t firstTrack = 0;
+			/**
+			 * Total number of tracks.
+			 */
+			int32_t trackNum = 0;
+		};
+
+		/**
+		 * Save a snapshot, replacing the old file atomically.
+		 * \param path			File Path
+		 * \param states		Surface States
+		 * \param bank			Bank Position
+		 * \return	Whether the snapshot was saved.
+		 */
+		static bool save(const std::string& path, const std::vector<SurfaceState>& states, const Bank& bank);
+		/**
+		 * Load a snapshot.
+		 * \param path			File Path
+		 * \return	The snapshot, or nullptr on failure, version mismatch or checksum mismatch.
+		 */
+		static std::unique_ptr<SurfaceSnapshot> load(const std::string& path);
+
+		/**
+		 * Unmap the file.
+		 */
+		~SurfaceSnapshot();
+
+		/**
+		 * Get the number of surfaces.
+		 */
+		int getSurfaceNum() const;
+		/**
+		 * Get the state of a surface, in the mapped file.
+		 * \param surface		Surface Index
+		 * \return	The state, or nullptr if the index is out of range.
+		 */
+		const SurfaceState* getState(int surface) const;
+		/**
+		 * Get the bank position.
+		 */
+		Bank getBank() const;
+
+		/**
+		 * Append the messages which repaint a surface from the snapshot.
+		 * \param surface		Surface Index
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Appended
+		 */
+		int repaint(int surface, std::vector<Message>& messages) const;
+		/**
+		 * Append the messages which change a surface from its current state to the snapshot.
+		 * \param surface		Surface Index
+		 * \param current		Current Surface State
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Appended
+		 */
+		int repaint(int surface, const SurfaceState& current, std::vector<Message>& messages) const;
+
+		/**
+		 * Get the checksum (FNV-1a) of a byte range.
+		 * \param data			Data
+		 * \param size			Data Size
+		 * \param hash			Checksum of the previous range, to chain ranges
+		 */
+		static uint32_t getChecksum(const void* data, std::size_t size, uint32_t hash = 2166136261u);
+
+	private:
+		struct alignas(64) Header final {
+			uint32_t magic;
+			uint32_t version;
+			uint32_t headerSize;
+			uint32_t stateSize;
+			uint32_t surfaceNum;
+			uint32_t checksum;
+			Bank bank;
+		};
+
+		static constexpr uint32_t Magic = 0x4D435346;
+		static constexpr uint32_t Version = 1;
+
+		void* handle = nullptr;
+		void* memory = nullptr;
+		std::size_t size = 0;
+
+		SurfaceSnapshot() = default;
+		SurfaceSnapshot(const SurfaceSnapshot&) = delete;
+		SurfaceSnapshot& operator=(const SurfaceSnapshot&) = delete;
+
+		const Header* getHeader() const;
+		const SurfaceState* getStates() const;
+
+		static std::size_t getFileSize(int surfaceNum);
+		static uint32_t getContentChecksum(const Header& header, const SurfaceState* states);
+		static bool write(const std::string& path, const Header& header, const std::vector<SurfaceState>& states);
+		bool map(const std::string& path);
+	};
+}
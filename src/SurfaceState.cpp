@@ -0,0 +1,129 @@
+/*****************************************************************//**
+ * \file	SurfaceState.cpp
+ * \brief	Display state of a Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceState.h"
+
+namespace mackieControl {
+	template <typename T, std::size_t Size>
+	static bool setValue(std::array<T, Size>& array, int index, T value) {
+		if (index < 0 || index >= static_cast<int>(Size) || array[index] == value) {
+			return false;
+		}
+		array[index] = value;
+		return true;
+	}
+
+	SurfaceState::SurfaceState() {
+		this->reset();
+	}
+
+	void SurfaceState::reset() {
+		this->LEDs.fill(VelocityMessage::Off);
+		this->faders.fill(0);
+		this->vPotLEDRings.fill(0);
+		this->LCD.fill(' ');
+		this->timeCodeBBTDisplay.fill(' ');
+		this->assignment7SegmentDisplay.fill(' ');
+		this->meters.fill(0);
+		this->meterOverload = 0;
+	}
+
+	bool SurfaceState::apply(const Message& message) {
+		if (message.isNote()) {
+			auto [type, vel] = message.getNoteData();
+			return setValue(this->LEDs, static_cast<int>(type), vel);
+		}
+
+		if (message.isCC()) {
+			auto [type, value] = message.getCCData();
+			int number = static_cast<int>(type);
+
+			if (number >= static_cast<int>(CCMessage::VPotLEDRing1) && number <= static_cast<int>(CCMessage::VPotLEDRing8)) {
+				return setValue(this->vPotLEDRings,
+					number - static_cast<int>(CCMessage::VPotLEDRing1), static_cast<uint8_t>(value));
+			}
+			if (number >= static_cast<int>(CCMessage::TimeCodeBBTDisplay1) && number <= static_cast<int>(CCMessage::TimeCodeBBTDisplay10)) {
+				return setValue(this->timeCodeBBTDisplay,
+					static_cast<int>(CCMessage::TimeCodeBBTDisplay10) - number, static_cast<uint8_t>(value));
+			}
+			if (number >= static_cast<int>(CCMessage::Assignment7SegmentDisplay1) && number <= static_cast<int>(CCMessage::Assignment7SegmentDisplay3)) {
+				return setValue(this->assignment7SegmentDisplay,
+					(number == static_cast<int>(CCMessage::Assignment7SegmentDisplay1)) ? 0 : 1, static_cast<uint8_t>(value));
+			}
+			return false;
+		}
+
+		if (message.isPitchWheel()) {
+			auto [channel, value] = message.getPitchWheelData();
+			return setValue(this->faders, channel - 1, static_cast<uint16_t>(value));
+		}
+
+		if (message.isChannelPressure()) {
+			auto [channel, value] = message.getChannelPressureData();
+			int index = channel - 1;
+			if (index < 0 || index >= ChannelNum) { return false; }
+
+			uint8_t overload = this->meterOverload;
+			if (value == 14) { overload |= (1 << index); }
+			else if (value == 15) { overload &= ~(1 << index); }
+			else if (value <= 12) { return setValue(this->meters, index, static_cast<uint8_t>(value)); }
+
+			bool changed = overload != this->meterOverload;
+			this->meterOverload = overload;
+			return changed;
+		}
+
+		if (message.isSysEx()) {
+			auto [type] = message.getSysExData();
+			switch (type) {
+			case SysExMessage::LCD: {
+				auto [place, data, size] = message.getLCDData();
+				int count = std::min<int>(size, static_cast<int>(this->LCD.size()) - place);
+				if (count <= 0 || std::memcmp(&this->LCD[place], data, count) == 0) { return false; }
+				std::memcpy(&this->LCD[place], data, count);
+				return true;
+			}
+			case SysExMessage::TimeCodeBBTDisplay: {
+				auto [data, size] = message.getTimeCodeBBTDisplayData();
+				int count = std::min<int>(size, static_cast<int>(this->timeCodeBBTDisplay.size()));
+				if (count <= 0 || std::memcmp(this->timeCodeBBTDisplay.data(), data, count) == 0) { return false; }
+				std::memcpy(this->timeCodeBBTDisplay.data(), data, count);
+				return true;
+			}
+			case SysExMessage::Assignment7SegmentDisplay: {
+				auto [data] = message.getAssignment7SegmentDisplayData();
+				if (this->assignment7SegmentDisplay == data) { return false; }
+				this->assignment7SegmentDisplay = data;
+				return true;
+			}
+			case SysExMessage::AllLEDsOff: {
+				auto old = this->LEDs;
+				this->LEDs.fill(VelocityMessage::Off);
+				return old != this->LEDs;
+			}
+			case SysExMessage::AllFaderstoMinimum: {
+				auto old = this->faders;
+				this->faders.fill(0);
+				return old != this->faders;
+			}
+			case SysExMessage::Reset: {
+				SurfaceState old = *this;
+				this->reset();
+				return old != *this;
+			}
+			default:
+				return false;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,87 @@
+/*****************************************************************//**
+ * \file	SurfaceState.h
+ * \brief	Display state of a Mackie Control surface.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+
+namespace mackieControl {
+	/**
+	 * Everything a Mackie Control surface shows: LEDs, faders, V-Pot LED rings, LCD, Time Code/BBT display,
+	 * assignment display and meters.
+	 * The state is a plain fixed-size structure, so it can be copied by memcpy and placed in shared or mapped memory.
+	 */
+	struct SurfaceState final {
+		/**
+		 * Number of LCD characters of one line.
+		 */
+		static constexpr int LCDLineSize = 56;
+		/**
+		 * Number of faders, including the master fader.
+		 */
+		static constexpr int FaderNum = 9;
+		/**
+		 * Number of channel strips.
+		 */
+		static constexpr int ChannelNum = 8;
+
+		/**
+		 * LED state, indexed by note number.
+		 */
+		std::array<VelocityMessage, 128> LEDs;
+		/**
+		 * Fader value, indexed by channel number - 1. The master fader is at index 8.
+		 */
+		std::array<uint16_t, FaderNum> faders;
+		/**
+		 * V-Pot LED Ring value, indexed by channel number - 1.
+		 */
+		std::array<uint8_t, ChannelNum> vPotLEDRings;
+		/**
+		 * LCD characters, upper line followed by lower line.
+		 */
+		std::array<char, LCDLineSize * 2> LCD;
+		/**
+		 * Time Code/BBT display characters (Mackie Control Character), from right to left.
+		 */
+		std::array<uint8_t, 10> timeCodeBBTDisplay;
+		/**
+		 * Assignment 7-Segment display characters (Mackie Control Character), from right to left.
+		 */
+		std::array<uint8_t, 2> assignment7SegmentDisplay;
+		/**
+		 * Meter value, indexed by meter channel number - 1.
+		 */
+		std::array<uint8_t, ChannelNum> meters;
+		/**
+		 * Meter overload bit mask, bit index is meter channel number - 1.
+		 */
+		uint8_t meterOverload;
+
+		/**
+		 * Create a blank state.
+		 */
+		SurfaceState();
+
+		/**
+		 * Set to blank state: all LEDs off, faders at minimum, LCD filled with spaces.
+		 */
+		void reset();
+
+		/**
+		 * Update the state by a message sent to the surface.
+		 * \return	Whether the message changed the state.
+		 */
+		bool apply(const Message& message);
+
+		bool operator==(const SurfaceState& other) const = default;
+	};
+}
@@ -0,0 +1,110 @@
+/*****************************************************************//**
+ * \file	VPotRingRenderer.cpp
+ * \brief	Batch V-Pot LED ring output from normalised parameter values.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "VPotRingRenderer.h"
+#include "MessageTable.h"
+#include <bit>
+
+namespace mackieControl {
+	VPotRingRenderer::VPotRingRenderer() {
+		this->flags.fill(0);
+		this->lastValues.fill(-1);
+		this->nextValues.fill(0);
+	}
+
+	void VPotRingRenderer::setMode(int channel, VPotLEDRingMode mode) {
+		if (channel < 1 || channel > ChannelNum) { return; }
+
+		auto& flag = this->flags[channel - 1];
+		bool centerLEDOn = flag & 64;
+		flag = Message::toVPotLEDRingValue(centerLEDOn, mode, 0);
+	}
+
+	void VPotRingRenderer::setCenterLED(int channel, bool centerLEDOn) {
+		if (channel < 1 || channel > ChannelNum) { return; }
+
+		auto& flag = this->flags[channel - 1];
+		auto mode = std::get<1>(Message::convertVPotLEDRingValue(flag));
+		flag = Message::toVPotLEDRingValue(centerLEDOn, mode, 0);
+	}
+
+	int VPotRingRenderer::render(std::span<const float, ChannelNum> values, std::vector<Message>& messages) {
+		if (this->update(values) == 0) { return 0; }
+
+		auto& table = MessageTable::getInstance();
+		int count = 0;
+		for (int i = 0; i < ChannelNum; i++) {
+			if (this->nextValues[i] != this->lastValues[i]) {
+				this->lastValues[i] = this->nextValues[i];
+				messages.emplace_back(table.getVPotLEDRing(i + 1, this->nextValues[i]));
+				count++;
+			}
+		}
+		return count;
+	}
+
+	int VPotRingRenderer::render(std::span<const float, ChannelNum> values, MidiBuffer& buffer, int sampleOffset) {
+		if (this->update(values) == 0) { return 0; }
+
+		int count = 0;
+		for (int i = 0; i < ChannelNum; i++) {
+			if (this->nextValues[i] != this->lastValues[i]) {
+				this->lastValues[i] = this->nextValues[i];
+				buffer.addEvent(MessageTable::getVPotLEDRingBytes(i + 1, this->nextValues[i]), 3, sampleOffset);
+				count++;
+			}
+		}
+		return count;
+	}
+
+	int VPotRingRenderer::getLastValue(int channel) const {
+		if (channel < 1 || channel > ChannelNum) { return -1; }
+		return this->lastValues[channel - 1];
+	}
+
+	void VPotRingRenderer::invalidate() {
+		this->lastValues.fill(-1);
+	}
+
+	int VPotRingRenderer::toRingPosition(float value) {
+		//Non-negative floats order like their bit patterns, so the clamp is done on integers and needs no branch.
+		//NaN is off like negative values, instead of ordering above 1. -0.0 has the sign bit set, so it is off too.
+		int32_t bits = std::bit_cast<int32_t>(value);
+		int32_t notNaN = -static_cast<int32_t>((bits & 0x7FFFFFFF) <= 0x7F800000);
+		int32_t on = ~(bits >> 31) & notNaN;
+		int32_t clamped = std::min(bits & on, std::bit_cast<int32_t>(1.f));
+
+		//Rounds half away from zero like std::round(). The fraction is exact, so a value just below .5 never rounds up
+		//the way adding 0.5 before truncating would.
+		float scaled = std::bit_cast<float>(clamped) * 10.f;
+		int truncated = static_cast<int>(scaled);
+		int position = truncated + static_cast<int>(scaled - static_cast<float>(truncated) >= 0.5f) + 1;
+		return position & on;
+	}
+
+	int VPotRingRenderer::update(std::span<const float, ChannelNum> values) {
+		//Fixed trip count without branches, so the compiler can vectorize both loops
+		for (int i = 0; i < ChannelNum; i++) {
+			int position = VPotRingRenderer::toRingPosition(values[i]);
+
+			//All LEDs off look the same in every mode, only the center LED is kept
+			int flag = this->flags[i];
+			int on = -static_cast<int>(position != 0);
+			this->nextValues[i] = (flag & 64) | (on & (flag | position));
+		}
+
+		int changed = 0;
+		for (int i = 0; i < ChannelNum; i++) {
+			changed += (this->nextValues[i] != this->lastValues[i]) ? 1 : 0;
+		}
+		return changed;
+	}
+}
@@ -0,0 +1,91 @@
+/*****************************************************************//**
+ * \file	VPotRingRenderer.h
+ * \brief	Batch V-Pot LED ring output from normalised parameter values.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "MackieControl.h"
+#import "MidiBuffer.h"
+#include <span>
+
+namespace mackieControl {
+	/**
+	 * Render the V-Pot LED rings of all strips at once.
+	 * Each strip has a LED ring mode and a center LED flag. A block of normalised values is quantised to ring values in
+	 * one branch-free pass over all strips, compared to the last sent ring values, and V-Pot LED Ring messages are only
+	 * emitted for rings whose visible LED pattern changed.
+	 */
+	class VPotRingRenderer final {
+	public:
+		/**
+		 * Number of V-Pot LED rings.
+		 */
+		static constexpr int ChannelNum = 8;
+
+		/**
+		 * Create a renderer. All rings are in single dot mode with the center LED off, and are sent on the first render.
+		 */
+		VPotRingRenderer();
+
+		/**
+		 * Set the LED ring mode of a strip.
+		 * \param channel		Channel Number (1-8)
+		 * \param mode			LED Ring Mode
+		 */
+		void setMode(int channel, VPotLEDRingMode mode);
+		/**
+		 * Set the center LED of a strip.
+		 * \param channel		Channel Number (1-8)
+		 * \param centerLEDOn	Center LED On/Off
+		 */
+		void setCenterLED(int channel, bool centerLEDOn);
+
+		/**
+		 * Render the values of all strips.
+		 * \param values		Values (0 to 1) of All Strips, negative or NaN to turn the LEDs off
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Emitted
+		 */
+		int render(std::span<const float, ChannelNum> values, std::vector<Message>& messages);
+		/**
+		 * Render the values of all strips.
+		 * \param values		Values (0 to 1) of All Strips, negative or NaN to turn the LEDs off
+		 * \param buffer		Output Buffer
+		 * \param sampleOffset	Sample Offset of the Messages
+		 * \return	Number of Messages Emitted
+		 */
+		int render(std::span<const float, ChannelNum> values, MidiBuffer& buffer, int sampleOffset);
+
+		/**
+		 * Get the last ring value sent to a strip.
+		 * \param channel		Channel Number (1-8)
+		 * \return	V-Pot LED Ring Value (see Message::toVPotLEDRingValue), or -1 if nothing has been sent.
+		 */
+		int getLastValue(int channel) const;
+		/**
+		 * Forget the last sent ring values, so every ring is sent on the next render.
+		 */
+		void invalidate();
+
+		/**
+		 * Quantise a normalised value to the LED position of a ring value.
+		 * \param value			Value (0 to 1), negative (including -0.0) or NaN to turn the LEDs off
+		 * \return	LED Position (1 + round(value * 10)), or 0 for off.
+		 */
+		static int toRingPosition(float value);
+
+	private:
+		std::array<int, ChannelNum> flags;
+		std::array<int, ChannelNum> lastValues;
+		std::array<int, ChannelNum> nextValues;
+
+		int update(std::span<const float, ChannelNum> values);
+	};
+}
@@ -0,0 +1,122 @@
+/*****************************************************************//**
+ * \file	VirtualSurface.cpp
+ * \brief	Emulated Mackie Control surface for headless testing.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "VirtualSurface.h"
+
+namespace mackieControl {
+	VirtualLink::VirtualLink(double bytesPerSecond)
+		: bytesPerSecond(bytesPerSecond) {}
+
+	double VirtualLink::send(int size, double time) {
+		this->busyUntil = std::max(this->busyUntil, time) + size / this->bytesPerSecond;
+		this->bytesSent += size;
+		return this->busyUntil;
+	}
+
+	void VirtualLink::reset() {
+		this->busyUntil = 0;
+		this->bytesSent = 0;
+	}
+
+	uint64_t VirtualLink::getBytesSent() const {
+		return this->bytesSent;
+	}
+
+	VirtualSurface::VirtualSurface(bool extender)
+		: extender(extender) {}
+
+	bool VirtualSurface::receive(const Message& message) {
+		if (!message.isMackieControl()) {
+			this->invalidCount++;
+			return false;
+		}
+
+		this->validCount++;
+		this->state.apply(message);
+		return true;
+	}
+
+	bool VirtualSurface::receive(const uint8_t* data, int size) {
+		return this->receive(Message{ MidiMessage{ data, size } });
+	}
+
+	void VirtualSurface::setInputConfig(const InputConfig& config) {
+		this->config = config;
+		this->random = (config.seed != 0) ? config.seed : 1;
+		this->faderCredit = this->vPotCredit = this->buttonCredit = 0;
+	}
+
+	int VirtualSurface::generateInput(double seconds, std::vector<Message>& messages) {
+		auto oldSize = messages.size();
+
+		this->faderCredit += this->config.faderMovesPerSecond * seconds;
+		while (this->faderCredit >= 1) {
+			this->faderCredit -= 1;
+
+			int faderNum = this->extender ? SurfaceState::ChannelNum : SurfaceState::FaderNum;
+			int index = this->nextRandom() % faderNum;
+			int value = this->nextRandom() % (1 << 14);
+			auto touch = static_cast<NoteMessage>(static_cast<int>(NoteMessage::FaderTouchCh1) + index);
+
+			messages.emplace_back(Message::createNote(touch, VelocityMessage::On));
+			messages.emplace_back(Message::createPitchWheel(index + 1, value));
+			messages.emplace_back(Message::createNote(touch, VelocityMessage::Off));
+			this->state.faders[index] = static_cast<uint16_t>(value);
+		}
+
+		this->vPotCredit += this->config.vPotTicksPerSecond * seconds;
+		while (this->vPotCredit >= 1) {
+			this->vPotCredit -= 1;
+
+			int index = this->nextRandom() % SurfaceState::ChannelNum;
+			auto type = (this->nextRandom() & 1) ? WheelType::CW : WheelType::CCW;
+			int ticks = 1 + this->nextRandom() % 3;
+
+			messages.emplace_back(Message::createCC(
+				static_cast<CCMessage>(static_cast<int>(CCMessage::VPot1) + index), Message::toVPotValue(type, ticks)));
+		}
+
+		this->buttonCredit += this->config.buttonPressesPerSecond * seconds;
+		while (this->buttonCredit >= 1) {
+			this->buttonCredit -= 1;
+
+			//Extenders only have channel strip buttons
+			int buttonNum = this->extender ? static_cast<int>(NoteMessage::ASSIGNMENTTRACK)
+				: static_cast<int>(NoteMessage::FaderTouchCh1);
+			auto button = static_cast<NoteMessage>(this->nextRandom() % buttonNum);
+
+			messages.emplace_back(Message::createNote(button, VelocityMessage::On));
+			messages.emplace_back(Message::createNote(button, VelocityMessage::Off));
+		}
+
+		return static_cast<int>(messages.size() - oldSize);
+	}
+
+	const SurfaceState& VirtualSurface::getState() const {
+		return this->state;
+	}
+
+	std::tuple<uint64_t, uint64_t> VirtualSurface::getReceivedCount() const {
+		return { this->validCount, this->invalidCount };
+	}
+
+	bool VirtualSurface::isExtender() const {
+		return this->extender;
+	}
+
+	uint32_t VirtualSurface::nextRandom() {
+		//xorshift32
+		this->random ^= this->random << 13;
+		this->random ^= this->random >> 17;
+		this->random ^= this->random << 5;
+		return this->random;
+	}
+}
@@ -0,0 +1,126 @@
+/*****************************************************************//**
+ * \file	VirtualSurface.h
+ * \brief	Emulated Mackie Control surface for headless testing.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include "SurfaceState.h"
+
+namespace mackieControl {
+	/**
+	 * Simulated serial MIDI link. Bytes leave the link one after another at the link rate, so bursts queue up.
+	 */
+	class VirtualLink final {
+	public:
+		/**
+		 * Bytes per second of a DIN MIDI link (31250 baud, 10 bits per byte).
+		 */
+		static constexpr double DINBytesPerSecond = 31250.0 / 10.0;
+
+		/**
+		 * Create a link.
+		 * \param bytesPerSecond	Link Rate
+		 */
+		explicit VirtualLink(double bytesPerSecond = DINBytesPerSecond);
+
+		/**
+		 * Send bytes at the time.
+		 * \param size			Data Size
+		 * \param time			Send Time (s)
+		 * \return	Arrival Time of the Last Byte (s)
+		 */
+		double send(int size, double time);
+		/**
+		 * Clear the queue.
+		 */
+		void reset();
+
+		/**
+		 * Get the total number of bytes sent.
+		 */
+		uint64_t getBytesSent() const;
+
+	private:
+		double bytesPerSecond;
+		double busyUntil = 0;
+		uint64_t bytesSent = 0;
+	};
+
+	/**
+	 * In-process emulation of a Mackie Control (MCU) or extender (XT) surface.
+	 * Messages received from the host are applied to an internal surface state, and user input (fader touches, V-Pot
+	 * spins, button presses) can be generated at configurable rates.
+	 */
+	class VirtualSurface final {
+	public:
+		/**
+		 * Rates of synthetic user input.
+		 */
+		struct InputConfig final {
+			double faderMovesPerSecond = 20;
+			double vPotTicksPerSecond = 20;
+			double buttonPressesPerSecond = 5;
+			uint32_t seed = 1;
+		};
+
+		/**
+		 * Create an emulated surface.
+		 * \param extender		Extender (XT) without master fader and transport section
+		 */
+		explicit VirtualSurface(bool extender = false);
+
+		/**
+		 * Apply a message received from the host.
+		 * \return	Whether the message is a valid Mackie Control message.
+		 */
+		bool receive(const Message& message);
+		/**
+		 * Apply raw MIDI data received from the host.
+		 * \return	Whether the data is a valid Mackie Control message.
+		 */
+		bool receive(const uint8_t* data, int size);
+
+		/**
+		 * Set the rates of synthetic user input.
+		 */
+		void setInputConfig(const InputConfig& config);
+		/**
+		 * Append the synthetic user input of a time span.
+		 * \param seconds		Time Span (s)
+		 * \param messages		Output Messages
+		 * \return	Number of Messages Appended
+		 */
+		int generateInput(double seconds, std::vector<Message>& messages);
+
+		/**
+		 * Get the emulated surface state.
+		 */
+		const SurfaceState& getState() const;
+		/**
+		 * Get the number of received messages.
+		 * \return	Valid Messages, Invalid Messages
+		 */
+		std::tuple<uint64_t, uint64_t> getReceivedCount() const;
+		/**
+		 * Check if this is an extender.
+		 */
+		bool isExtender() const;
+
+	private:
+		bool extender;
+		SurfaceState state;
+		InputConfig config;
+		uint32_t random = 1;
+		double faderCredit = 0, vPotCredit = 0, buttonCredit = 0;
+		uint64_t validCount = 0, invalidCount = 0;
+
+		uint32_t nextRandom();
+	};
+}
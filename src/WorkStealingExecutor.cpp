@@ -0,0 +1,109 @@
+/*****************************************************************//**
+ * \file	WorkStealingExecutor.cpp
+ * \brief	Work-stealing thread pool.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "WorkStealingExecutor.h"
+
+namespace mackieControl {
+	WorkStealingExecutor::WorkStealingExecutor(int threadNum) {
+		if (threadNum <= 0) {
+			threadNum = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+		}
+
+		for (int i = 0; i < threadNum; i++) {
+			this->workers.push_back(std::make_unique<Worker>());
+		}
+		for (int i = 0; i < threadNum; i++) {
+			this->workers[i]->thread = std::thread{ [this, i] { this->run(i); } };
+		}
+	}
+
+	WorkStealingExecutor::~WorkStealingExecutor() {
+		{
+			std::lock_guard lock{ this->sleepMutex };
+			this->stopping = true;
+		}
+		this->wakeUp.notify_all();
+
+		for (auto& worker : this->workers) {
+			worker->thread.join();
+		}
+	}
+
+	void WorkStealingExecutor::submit(Task task, int worker) {
+		auto& target = *(this->workers[static_cast<std::size_t>(worker) % this->workers.size()]);
+		this->unfinished++;
+		{
+			std::lock_guard lock{ target.mutex };
+			target.tasks.push_back(std::move(task));
+			this->queued++;
+		}
+
+		{
+			std::lock_guard lock{ this->sleepMutex };
+		}
+		this->wakeUp.notify_one();
+	}
+
+	void WorkStealingExecutor::waitIdle() {
+		std::unique_lock lock{ this->sleepMutex };
+		this->idle.wait(lock, [this] { return this->unfinished == 0; });
+	}
+
+	int WorkStealingExecutor::getThreadNum() const {
+		return static_cast<int>(this->workers.size());
+	}
+
+	void WorkStealingExecutor::run(int index) {
+		while (true) {
+			Task task;
+			if (this->pop(index, task) || this->steal(index, task)) {
+				task();
+
+				if (--(this->unfinished) == 0) {
+					std::lock_guard lock{ this->sleepMutex };
+					this->idle.notify_all();
+				}
+				continue;
+			}
+
+			//The queued count only covers tasks still in a queue, so a running task doesn't keep idle workers spinning
+			std::unique_lock lock{ this->sleepMutex };
+			this->wakeUp.wait(lock, [this] { return this->stopping || this->queued > 0; });
+			if (this->stopping && this->queued == 0) { return; }
+		}
+	}
+
+	bool WorkStealingExecutor::pop(int index, Task& task) {
+		auto& worker = *(this->workers[index]);
+		std::lock_guard lock{ worker.mutex };
+		if (worker.tasks.empty()) { return false; }
+
+		task = std::move(worker.tasks.back());
+		worker.tasks.pop_back();
+		this->queued--;
+		return true;
+	}
+
+	bool WorkStealingExecutor::steal(int index, Task& task) {
+		int size = static_cast<int>(this->workers.size());
+		for (int i = 1; i < size; i++) {
+			auto& worker = *(this->workers[(index + i) % size]);
+			std::lock_guard lock{ worker.mutex };
+			if (worker.tasks.empty()) { continue; }
+
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+			this->queued--;
+			return true;
+		}
+		return false;
+	}
+}
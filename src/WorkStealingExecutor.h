@@ -0,0 +1,80 @@
+/*****************************************************************//**
+ * \file	WorkStealingExecutor.h
+ * \brief	Work-stealing thread pool.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+namespace mackieControl {
+	/**
+	 * Thread pool where each worker has its own task queue.
+	 * A task is queued to the worker it prefers, so related work stays on one core, and idle workers steal tasks
+	 * from the others.
+	 */
+	class WorkStealingExecutor final {
+	public:
+		using Task = std::function<void()>;
+
+		/**
+		 * Start the workers.
+		 * \param threadNum		Number of Workers (0 for hardware concurrency)
+		 */
+		explicit WorkStealingExecutor(int threadNum = 0);
+		/**
+		 * Finish all queued tasks and stop the workers.
+		 */
+		~WorkStealingExecutor();
+
+		/**
+		 * Queue a task.
+		 * \param task			Task
+		 * \param worker		Preferred Worker Index
+		 */
+		void submit(Task task, int worker);
+		/**
+		 * Block until all queued tasks are finished.
+		 */
+		void waitIdle();
+
+		/**
+		 * Get the number of workers.
+		 */
+		int getThreadNum() const;
+
+	private:
+		struct Worker final {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+			std::thread thread;
+		};
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::mutex sleepMutex;
+		std::condition_variable wakeUp, idle;
+		std::atomic<int> queued = 0;		//Tasks in the queues, changed under the lock of the queue
+		std::atomic<int> unfinished = 0;
+		bool stopping = false;
+
+		void run(int index);
+		bool pop(int index, Task& task);
+		bool steal(int index, Task& task);
+
+		WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+		WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+	};
+}
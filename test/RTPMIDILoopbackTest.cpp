@@ -0,0 +1,97 @@
+/*****************************************************************//**
+ * \file	RTPMIDILoopbackTest.cpp
+ * \brief	Loopback test of the RTP-MIDI transport.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "RTPMIDILoopback.h"
+#include <cstdio>
+
+using namespace mackieControl;
+
+static int failures = 0;
+
+static void expect(bool condition, const char* what) {
+	if (!condition) {
+		std::printf("FAILED: %s\n", what);
+		failures++;
+	}
+}
+
+static bool sendRaw(RTPMIDITransport& transport, std::initializer_list<uint8_t> data) {
+	return transport.send(data.begin(), static_cast<int>(data.size()), 0) && transport.flush();
+}
+
+/**
+ * Messages, running status and segmented system exclusive messages arrive unchanged.
+ */
+static void testStream() {
+	RTPMIDILoopback::Config config;
+	config.messageNum = 20000;
+	config.latencyNum = 1000;
+	config.sysExInterval = 16;
+	config.maxPayloadSize = 64;
+
+	auto report = RTPMIDILoopback::run(config);
+	expect(report.connected, "stream: transports bound to loopback");
+	expect(report.mismatches == 0, "stream: messages arrive unchanged and in order");
+	expect(report.messagesReceived == report.messagesSent, "stream: all messages arrive");
+	expect(report.packetsLost == 0, "stream: no packets lost");
+}
+
+/**
+ * A system exclusive message which lost a segment is not delivered, and does not corrupt the next one.
+ */
+static void testLostSegment() {
+	RTPMIDITransport::Config config;
+	config.batchWindowMs = 1e9;
+	RTPMIDITransport sender{ config }, receiver{ config }, sink{ config };
+	if (!sender.bind(0, "127.0.0.1") || !receiver.bind(0, "127.0.0.1") || !sink.bind(0, "127.0.0.1")) {
+		expect(false, "lost segment: transports bound to loopback");
+		return;
+	}
+
+	std::vector<Message> messages;
+	sender.setPeer("127.0.0.1", receiver.getBoundPort());
+	sendRaw(sender, { 0xF0, 0x00, 0x00, 0x66, 0xF0 });
+
+	//The middle segment goes elsewhere
+	sender.setPeer("127.0.0.1", sink.getBoundPort());
+	sendRaw(sender, { 0xF7, 0x14, 0x12, 0xF0 });
+
+	sender.setPeer("127.0.0.1", receiver.getBoundPort());
+	sendRaw(sender, { 0xF7, 0x41, 0xF7 });
+	sendRaw(sender, { 0xF0, 0x00, 0x00, 0x66, 0x14, 0x0A, 0x01, 0xF7 });
+	while (receiver.receive(messages, 100) > 0) {}
+
+	expect(receiver.getCounters().packetsLost == 1, "lost segment: loss is counted");
+	expect(messages.size() == 1, "lost segment: only the complete message is delivered");
+	expect(!messages.empty() && messages.front().getRawDataSize() == 8 && messages.front().getRawData()[5] == 0x0A,
+		"lost segment: the next message is intact");
+}
+
+/**
+ * Only packets which were written are counted.
+ */
+static void testUnboundCounters() {
+	RTPMIDITransport transport;
+	uint8_t data[] = { 0x90, 0x5E, 0x7F };
+	transport.send(data, 3, 0);
+	expect(!transport.flush(), "counters: flush without socket fails");
+	expect(transport.getCounters().packetsSent == 0, "counters: failed packets are not counted");
+	expect(transport.getCounters().messagesSent == 0, "counters: failed messages are not counted");
+}
+
+int main() {
+	testStream();
+	testLostSegment();
+	testUnboundCounters();
+
+	std::printf("%s\n", failures ? "RTPMIDILoopbackTest failed" : "RTPMIDILoopbackTest passed");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/*****************************************************************//**
+ * \file	SurfaceMirrorLoopbackTest.cpp
+ * \brief	Loopback test of surface mirroring over UDP.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "SurfaceMirror.h"
+#import "DatagramSocket.h"
+#include <cstdio>
+
+using namespace mackieControl;
+
+static int failures = 0;
+
+static void expect(bool condition, const char* what) {
+	if (!condition) {
+		std::printf("FAILED: %s\n", what);
+		failures++;
+	}
+}
+
+/**
+ * Change a little of everything, as a session with running automation does.
+ */
+static void change(SurfaceState& state, int frame) {
+	state.faders[frame % SurfaceState::FaderNum] = static_cast<uint16_t>((frame * 613) & 0x3FFF);
+	state.meters[frame % SurfaceState::ChannelNum] = static_cast<uint8_t>(frame % 13);
+	state.LEDs[frame % 128] = (frame & 1) ? VelocityMessage::On : VelocityMessage::Off;
+	state.vPotLEDRings[frame % SurfaceState::ChannelNum] = static_cast<uint8_t>(1 + frame % 11);
+	state.LCD[(frame * 7) % state.LCD.size()] = static_cast<char>('A' + frame % 26);
+	state.timeCodeBBTDisplay[frame % 10] = static_cast<uint8_t>(0x30 + frame % 10);
+}
+
+/**
+ * The source sends frames to the client over UDP, the client sends keyframe requests back.
+ */
+class Link final {
+public:
+	bool open() {
+		return this->source.bindToPort(0, "127.0.0.1") && this->client.bindToPort(0, "127.0.0.1");
+	}
+
+	bool sendFrame(const std::vector<uint8_t>& frame) {
+		int size = static_cast<int>(frame.size());
+		return this->source.write("127.0.0.1", this->client.getBoundPort(), frame.data(), size) == size;
+	}
+	int receiveFrame(std::vector<uint8_t>& frame) {
+		return this->receive(this->client, frame);
+	}
+
+	bool sendRequest() {
+		uint8_t request = 1;
+		return this->client.write("127.0.0.1", this->source.getBoundPort(), &request, 1) == 1;
+	}
+	bool receiveRequest() {
+		std::vector<uint8_t> request;
+		return this->receive(this->source, request) == 1;
+	}
+
+private:
+	DatagramSocket source, client;
+
+	static int receive(DatagramSocket& socket, std::vector<uint8_t>& data) {
+		data.resize(65536);
+		if (socket.waitUntilReady(true, 1000) <= 0) { return 0; }
+		int size = socket.read(data.data(), static_cast<int>(data.size()), false);
+		data.resize(std::max(size, 0));
+		return size;
+	}
+};
+
+int main() {
+	Link link;
+	if (!link.open()) {
+		std::printf("FAILED: sockets bound to loopback\n");
+		return 1;
+	}
+
+	SurfaceState source;
+	SurfaceMirrorEncoder encoder{ 1000 };
+	SurfaceMirrorDecoder decoder;
+	std::vector<uint8_t> frame;
+	int frameNum = 0;
+
+	auto step = [&](bool drop) {
+		change(source, frameNum++);
+		frame.clear();
+		if (encoder.encode(source, frame) == 0 || drop) { return false; }
+		link.sendFrame(frame);
+		return link.receiveFrame(frame) > 0 && decoder.decode(frame.data(), frame.size());
+	};
+
+	//Keyframe, then deltas
+	bool applied = true;
+	for (int i = 0; i < 20; i++) {
+		applied = step(false) && applied;
+	}
+	expect(applied, "synced: every frame is applied");
+	expect(decoder.isSynced() && decoder.getState() == source, "synced: the client shows the source state");
+
+	//One lost frame unsyncs the client, and it stays unsynced on the deltas after it
+	step(true);
+	expect(!step(false), "lost frame: the next delta is rejected");
+	expect(!decoder.isSynced(), "lost frame: the client is unsynced");
+	expect(!step(false), "lost frame: later deltas are rejected");
+
+	//The client asks for a keyframe
+	expect(link.sendRequest() && link.receiveRequest(), "resync: the request arrives");
+	encoder.requestKeyframe();
+	expect(step(false), "resync: the keyframe is applied");
+	expect(frame.size() > 0 && frame[0] == 0, "resync: the frame is a keyframe");
+	expect(decoder.isSynced(), "resync: the client is synced");
+
+	for (int i = 0; i < 20; i++) {
+		step(false);
+	}
+	expect(decoder.isSynced() && decoder.getState() == source, "resync: the client ends with the source state");
+
+	auto counters = encoder.getCounters();
+	expect(counters.keyframes == 2, "counters: one keyframe at start and one on request");
+
+	std::printf("%s\n", failures ? "SurfaceMirrorLoopbackTest failed" : "SurfaceMirrorLoopbackTest passed");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+/*****************************************************************//**
+ * \file	UMPRoundTripTest.cpp
+ * \brief	Round trip test of the Universal MIDI Packet encoder and decoder.
+ *
+ * \author	WuChang
+ * \email	31423836@qq.com
+ * \date	July 2023
+ * \version	1.0.2
+ * \license	MIT License
+ *********************************************************************/
+
+#include "MessageUMP.h"
+#include <cstdio>
+
+using namespace mackieControl;
+
+static int failures = 0;
+
+static void expect(bool condition, const char* what) {
+	if (!condition) {
+		std::printf("FAILED: %s\n", what);
+		failures++;
+	}
+}
+
+static bool isSame(const Message& a, const Message& b) {
+	return a.getRawDataSize() == b.getRawDataSize()
+		&& std::equal(a.getRawData(), a.getRawData() + a.getRawDataSize(), b.getRawData());
+}
+
+/**
+ * One message of every kind the library creates, in both directions.
+ */
+static std::vector<Message> createMessages() {
+	std::vector<Message> messages;
+	std::array<uint8_t, 7> serialNum = { 'S', 'E', 'R', 'I', 'A', 'L', '1' };
+
+	//Host to surface
+	for (auto type : validNoteMessage) {
+		messages.emplace_back(Message::createNote(type, VelocityMessage::On));
+		messages.emplace_back(Message::createNote(type, VelocityMessage::Flashing));
+		messages.emplace_back(Message::createNote(type, VelocityMessage::Off));
+	}
+	for (auto type : validCCMessage) {
+		messages.emplace_back(Message::createCC(type, 0x41));
+	}
+	for (int channel = 1; channel <= 9; channel++) {
+		messages.emplace_back(Message::createPitchWheel(channel, 0));
+		messages.emplace_back(Message::createPitchWheel(channel, 8191));
+		messages.emplace_back(Message::createPitchWheel(channel, 16383));
+	}
+	for (int channel = 1; channel <= 8; channel++) {
+		messages.emplace_back(Message::createChannelPressure(channel, 12));
+	}
+	messages.emplace_back(Message::createDeviceQuery());
+	messages.emplace_back(Message::createHostConnectionReply(serialNum, 0x12345678));
+	messages.emplace_back(Message::createLCDBackLightSaver(1, 15));
+	messages.emplace_back(Message::createTouchlessMovableFaders(1));
+	messages.emplace_back(Message::createFaderTouchSensitivity(3, 4));
+	messages.emplace_back(Message::createGoOffline());
+	uint8_t timeCode[10] = { 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30 };
+	messages.emplace_back(Message::createTimeCodeBBTDisplay(timeCode, 10));
+	messages.emplace_back(Message::createAssignment7SegmentDisplay({ 0x31, 0x32 }));
+	messages.emplace_back(Message::createVersionRequest());
+	messages.emplace_back(Message::createChannelMeterMode(2, 1));
+	messages.emplace_back(Message::createGlobalLCDMeterMode(1));
+	messages.emplace_back(Message::createAllFaderstoMinimum());
+	messages.emplace_back(Message::createAllLEDsOff());
+	messages.emplace_back(Message::createReset());
+
+	//System exclusive messages of 1 to 112 LCD characters, spanning up to 20 packets
+	char text[112];
+	for (int i = 0; i < 112; i++) {
+		text[i] = static_cast<char>('A' + i % 26);
+	}
+	for (int size : { 0, 1, 6, 7, 56, 112 }) {
+		messages.emplace_back(Message::createLCD(static_cast<uint8_t>(112 - size), text, size));
+	}
+
+	//Surface to host
+	messages.emplace_back(Message::createHostConnectionQuery(serialNum, 0x01020304));
+	messages.emplace_back(Message::createHostConnectionConfirmation(serialNum));
+	messages.emplace_back(Message::createHostConnectionError(serialNum));
+	messages.emplace_back(Message::createVersionReply("1.02", 4));
+
+	return messages;
+}
+
+/**
+ * Message to words to message, one message at a time and as one stream decoded in chunks.
+ */
+static void testMessages() {
+	auto messages = createMessages();
+	UMPEncoder encoder{ 3 };
+	UMPDecoder decoder{ 3 };
+
+	std::vector<uint32_t> stream;
+	std::vector<Message> decoded;
+	for (auto& message : messages) {
+		std::vector<uint32_t> words;
+		encoder.encode(message, words);
+		expect(static_cast<int>(words.size()) == UMPEncoder::getNumWords(message), "messages: getNumWords matches encode");
+
+		decoded.clear();
+		int consumed = decoder.decode(words.data(), static_cast<int>(words.size()), decoded);
+		expect(consumed == static_cast<int>(words.size()), "messages: all words consumed");
+		expect(decoded.size() == 1 && isSame(decoded.front(), message), "messages: message round trips");
+		stream.insert(stream.end(), words.begin(), words.end());
+	}
+
+	//Chunks of every size split packets anywhere, words not consumed yet are passed again with the next chunk
+	for (int chunk = 1; chunk <= 5; chunk++) {
+		decoded.clear();
+		std::vector<uint32_t> pending;
+		for (std::size_t pos = 0; pos < stream.size(); pos += chunk) {
+			pending.insert(pending.end(), stream.begin() + pos, stream.begin() + std::min(pos + chunk, stream.size()));
+			int consumed = decoder.decode(pending.data(), static_cast<int>(pending.size()), decoded);
+			pending.erase(pending.begin(), pending.begin() + consumed);
+		}
+		expect(pending.empty(), "messages: chunked stream fully consumed");
+		bool same = decoded.size() == messages.size();
+		for (std::size_t i = 0; same && i < messages.size(); i++) {
+			same = isSame(decoded[i], messages[i]);
+		}
+		expect(same, "messages: chunked stream round trips");
+	}
+}
+
+/**
+ * Words to message to words, so what a UMP endpoint sends is re-encoded unchanged.
+ */
+static void testWords() {
+	UMPEncoder encoder{ 0 };
+	UMPDecoder decoder{ 0 };
+
+	std::vector<uint32_t> words = {
+		0x20903C7F,		//Note on
+		0x20803C00,		//Note off
+		0x20B01041,		//Controller
+		0x20E07F3F,		//Pitch wheel
+		0x20D01C00,		//Channel pressure
+	};
+	//LCD system exclusive message in start, continue and end packets
+	words.insert(words.end(), {
+		0x30160000, 0x66141200,
+		0x30264142, 0x43444546,
+		0x30334748, 0x49000000 });
+
+	std::vector<Message> messages;
+	int consumed = decoder.decode(words.data(), static_cast<int>(words.size()), messages);
+	expect(consumed == static_cast<int>(words.size()), "words: all words consumed");
+	expect(messages.size() == 6, "words: one message per channel voice packet and one system exclusive message");
+
+	std::vector<uint32_t> encoded;
+	for (auto& message : messages) {
+		encoder.encode(message, encoded);
+	}
+	expect(encoded == words, "words: words round trip");
+
+	//Other groups and message types are skipped
+	std::vector<uint32_t> skipped = { 0x21903C7F, 0x10F80000, 0x40903C00, 0x7F000000 };
+	messages.clear();
+	decoder.decode(skipped.data(), static_cast<int>(skipped.size()), messages);
+	expect(messages.empty(), "words: other groups and types are skipped");
+}
+
+/**
+ * encodeLCD writes the same words as encoding createLCD.
+ */
+static void testLCD() {
+	UMPEncoder encoder;
+	const char* text = "Mackie Control Universal Pro LCD line of 56 characters.";
+	for (int size = 0; size <= 55; size += 11) {
+		std::vector<uint32_t> direct, created;
+		encoder.encodeLCD(14, text, size, direct);
+		encoder.encode(Message::createLCD(14, text, size), created);
+		expect(direct == created, "LCD: encodeLCD matches createLCD");
+	}
+}
+
+/**
+ * System messages other than system exclusive are not encoded.
+ */
+static void testSystem() {
+	UMPEncoder encoder;
+	uint8_t data[] = { 0xF8 };
+	std::vector<uint32_t> words;
+	encoder.encode(data, 1, words);
+	expect(words.empty(), "system: real time messages are not encoded");
+}
+
+int main() {
+	testMessages();
+	testWords();
+	testLCD();
+	testSystem();
+
+	std::printf("%s\n", failures ? "UMPRoundTripTest failed" : "UMPRoundTripTest passed");
+	return failures ? 1 : 0;
+}